@@ -1,3 +1,6 @@
+// Sin claves dibuja con u_Color; con USE_TEXTURE, con la textura multiplicada por u_Color
+#feature USE_TEXTURE
+
 #shader vertex
 #version 330 core
 
@@ -6,11 +9,12 @@ layout(location = 1) in vec2 texCoord;
 
 out vec2 v_TexCoord;
 
-uniform mat4 u_MVP;
+#include "Camera.glsl"
+#include "Object.glsl"
 
 void main()
 {
-   gl_Position = u_MVP * position;
+   gl_Position = u_ViewProjection * u_Model * position;
    v_TexCoord = texCoord;
 }
 
@@ -22,10 +26,15 @@ layout(location = 0) out vec4 color;
 in vec2 v_TexCoord;
 
 uniform vec4 u_Color;
+#ifdef USE_TEXTURE
 uniform sampler2D u_Texture;
+#endif
 
 void main()
 {
-	vec4 texColor = texture(u_Texture, v_TexCoord);
-	color = texColor;
+#ifdef USE_TEXTURE
+	color = texture(u_Texture, v_TexCoord) * u_Color;
+#else
+	color = u_Color;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,7 @@
+// Compartido por todos los programas; lo llena Renderer::BeginScene una vez por frame
+layout(std140) uniform Camera
+{
+	mat4 u_ViewProjection;
+	mat4 u_View;
+	mat4 u_Projection;
+};
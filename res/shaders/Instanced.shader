@@ -0,0 +1,29 @@
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec4 position;
+// Atributos por instancia: la matriz ocupa las ubicaciones 1 a 4
+layout(location = 1) in mat4 instanceModel;
+layout(location = 5) in vec4 instanceColor;
+
+out vec4 v_Color;
+
+#include "Camera.glsl"
+
+void main()
+{
+   gl_Position = u_ViewProjection * instanceModel * position;
+   v_Color = instanceColor;
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main()
+{
+	color = v_Color;
+}
\ No newline at end of file
@@ -0,0 +1,5 @@
+// Un tramo por objeto del buffer que arma Renderer::Flush
+layout(std140) uniform Object
+{
+	mat4 u_Model;
+};
@@ -0,0 +1,49 @@
+// Vrtices de ShapePacker. Con QUANTIZED la posicin llega normalizada a [-1, 1] dentro de los lmites de la figura
+// y u_Dequantize la devuelve a su lugar; las UV y el color ya llegan normalizados por el formato del atributo
+#feature QUANTIZED
+
+#shader vertex
+#version 330 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 color;
+// Atributos por instancia: la matriz ocupa las ubicaciones 3 a 6
+layout(location = 3) in mat4 instanceModel;
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+
+#include "Camera.glsl"
+
+#ifdef QUANTIZED
+// xy escala, zw desplazamiento
+uniform vec4 u_Dequantize;
+#endif
+
+void main()
+{
+#ifdef QUANTIZED
+   vec2 p = position * u_Dequantize.xy + u_Dequantize.zw;
+#else
+   vec2 p = position;
+#endif
+   gl_Position = u_ViewProjection * instanceModel * vec4(p, 0.0, 1.0);
+   v_TexCoord = texCoord;
+   v_Color = color;
+}
+
+#shader fragment
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+
+void main()
+{
+	// Franjas segn las UV, para que se note si se cuantizaron mal
+	float stripe = step(0.5, fract(v_TexCoord.x * 4.0));
+	color = v_Color * (0.75 + 0.25 * stripe);
+}
\ No newline at end of file
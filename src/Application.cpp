@@ -1,14 +1,23 @@
 #include <iostream>
+#include <string>
 #include "GL/glew.h"
 
 #include "Display.h"
 #include "shapes/Square.h"
 
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "GLDispatch.h"
+#include "Profiler.h"
+#include "ShaderCache.h"
+#include "ShaderLibrary.h"
+#include "ShaderBundle.h"
+#include "ShaderWatcher.h"
 #include "VertexBuffer.h"
 #include "VertexBufferLayout.h"
 #include "IndexBuffer.h"
 #include "VertexArray.h"
+#include "VertexArrayCache.h"
 #include "Shader.h"
 #include "Texture.h"
 
@@ -20,9 +29,57 @@
 
 #include "tests/TestClearColor.h"
 #include "tests/TestTexture2D.h"
+#include "tests/TestBatchRenderer2D.h"
+#include "tests/TestInstancing.h"
+#include "tests/TestMultiDrawIndirect.h"
+#include "tests/TestBufferUpdate.h"
+#include "tests/TestBufferArena.h"
+#include "tests/TestShapeFormats.h"
+#include "tests/HeadlessBenchmark.h"
+
+static void RegisterTests(test::TestMenu& testMenu)
+{
+    testMenu.RegisterTest<test::TestClearColor>("Clear color");
+    testMenu.RegisterTest<test::TestTexture2D>("2D Texture");
+    testMenu.RegisterTest<test::TestBatchRenderer2D>("Batch rendering");
+    testMenu.RegisterTest<test::TestInstancing>("Instancing");
+    testMenu.RegisterTest<test::TestMultiDrawIndirect>("Multi draw indirect");
+    testMenu.RegisterTest<test::TestBufferUpdate>("Buffer updates");
+    testMenu.RegisterTest<test::TestBufferArena>("Buffer arena");
+    testMenu.RegisterTest<test::TestShapeFormats>("Shape vertex formats");
+}
+
+// Libera lo que guarda objetos de OpenGL en estticos mientras el backend (real o falso) todava existe,
+// en lugar de dejarlo para la destruccin de estticos, cuyo orden no est definido
+static void Shutdown()
+{
+    VertexArrayCache::Shutdown();
+    ShaderLibrary::Shutdown();
+    ShaderBundle::Close();
+    Renderer::Shutdown();
+}
 
-int main(void)
+int main(int argc, char** argv)
 {
+    /*
+        Con --headless-bench [frames] no se crea ninguna ventana ni contexto: OpenGL se reemplaza por el backend
+        falso y cada test se corre la cantidad de frames pedida para medir solo el costo de CPU de enviar los dibujos.
+    */
+    if (argc > 1 && std::string(argv[1]) == "--headless-bench")
+    {
+        GLDispatch::UseMock();
+
+        test::Test* currentTest = nullptr;
+        test::TestMenu testMenu(currentTest);
+        RegisterTests(testMenu);
+
+        unsigned int frames = argc > 2 ? (unsigned int)std::stoul(argv[2]) : 1000;
+        test::RunHeadlessBenchmark(testMenu, frames);
+
+        Shutdown();
+        return 0;
+    }
+
     Display window(960, 540, "Hello World!");
 
     window.setSwapInterval(1);
@@ -31,28 +88,69 @@ int main(void)
     if (err != GLEW_OK)
         std::cerr << "Error! " << glewGetErrorString(err) << std::endl;
 
+    GLDispatch::UseGLEW();
+
     std::cout << glGetString(GL_VERSION) << std::endl;
 
+    GLSetErrorCheckLevel((GLErrorCheckLevel)GL_ERROR_CHECK);
+    GLSetDebugMessageFilter(GL_DONT_CARE, GL_DEBUG_SEVERITY_LOW);
+
+    // Deja que el driver use todos los hilos que quiera para compilar y enlazar en segundo plano
+    if (g_GLCaps.ParallelShaderCompile)
+    {
+        GLCall(glMaxShaderCompilerThreadsKHR(0xffffffff));
+    }
+
+    ShaderWatcher shaderWatcher("res/shaders");
+
+#ifndef _DEBUG
+    // En debug se lee siempre el cdigo fuente, para no usar un paquete viejo mientras se editan los shaders
+    if (ShaderBundle::Open("res/shaders.bundle"))
+        std::cout << "Shaders loaded from res/shaders.bundle" << std::endl;
+#endif
+
+    // Se mandan a compilar todos juntos antes del primer frame; cada test espera solo por el que usa
+    ShaderLibrary::Register("res/shaders/Basic.shader");
+    ShaderLibrary::Register("res/shaders/Batch.shader");
+    ShaderLibrary::Register("res/shaders/Instanced.shader");
+    ShaderLibrary::Register("res/shaders/Shape.shader");
+    ShaderLibrary::CompileAll();
+
     Renderer renderer;
 
     test::Test* currentTest = nullptr;
     test::TestMenu* testMenu = new test::TestMenu(currentTest);
     currentTest = testMenu;
 
-    testMenu->RegisterTest<test::TestClearColor>("Clear color");
-    testMenu->RegisterTest<test::TestTexture2D>("2D Texture");
+    RegisterTests(*testMenu);
 
     /* Loop until the user closes the window */
     while (!window.windowShouldClose())
     {
+        Profiler::BeginFrame();
+        GLStateCache::NewFrame();
+        Shader::ResetUniformStats();
+
+        // Los shaders editados se vuelven a compilar sin frenar el frame; el programa viejo sigue en uso hasta que el nuevo est listo
+        for (const std::string& path : shaderWatcher.Poll())
+            Shader::ReloadFile(path);
+        Shader::UpdateReloads();
+
         GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
         renderer.Clear();
 
         window.ImGui_NewFrame();
         if (currentTest)
         {
-            currentTest->OnUpdate(0.0f);
-            currentTest->OnRender();
+            {
+                PROFILE_SCOPE("OnUpdate");
+                currentTest->OnUpdate(0.0f);
+            }
+            {
+                PROFILE_SCOPE("OnRender");
+                PROFILE_GPU_SCOPE("OnRender");
+                currentTest->OnRender();
+            }
             ImGui::Begin("Test");
             if (currentTest != testMenu && ImGui::Button("<-"))
             {
@@ -60,11 +158,41 @@ int main(void)
                 currentTest = testMenu;
             }
             currentTest->OnImGuiRender();
+
+            const GLStateCache::Stats& cacheStats = GLStateCache::GetFrameStats();
+            ImGui::Separator();
+            ImGui::Text("GL state cache: %u skipped, %u issued", cacheStats.Hits, cacheStats.Misses);
+
+            const Shader::UniformStats& uniformStats = Shader::GetUniformStats();
+            ImGui::Text("Uniform uploads: %u skipped, %u issued", uniformStats.Skipped, uniformStats.Issued);
+
+            const ShaderCache::Stats& shaderStats = ShaderCache::GetStats();
+            ImGui::Text("Shader cache: %u hits (%.2f ms), %u misses (%.2f ms), %u rejected", shaderStats.Hits,
+                shaderStats.HitTime, shaderStats.Misses, shaderStats.MissTime, shaderStats.Rejected);
+
+            const ShaderLibrary::Stats& libraryStats = ShaderLibrary::GetStats();
+            ImGui::Text("Shader library: %u programs submitted in %.2f ms", libraryStats.Submitted, libraryStats.SubmitTime);
+
+            static const char* errorCheckLevels[] = { "Off", "Per frame", "Per call", "Debug output" };
+            int errorCheckLevel = (int)GLGetErrorCheckLevel();
+            if (ImGui::Combo("GL error checking", &errorCheckLevel, errorCheckLevels, GL_ERROR_CHECK + 1))
+                GLSetErrorCheckLevel((GLErrorCheckLevel)errorCheckLevel);
             ImGui::End();
         }
 
-        ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        Profiler::OnImGuiRender();
+
+        {
+            PROFILE_SCOPE("ImGui");
+            PROFILE_GPU_SCOPE("ImGui");
+            ImGui::Render();
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+        // ImGui cambia el estado de OpenGL por su cuenta
+        GLStateCache::Invalidate();
+
+        GLCheckFrameErrors();
+        Profiler::EndFrame();
 
         window.swapBuffers();
         window.pollEvents();
@@ -75,5 +203,7 @@ int main(void)
 
     delete currentTest;
 
+    Shutdown();
+
     return 0;
 }
@@ -0,0 +1,260 @@
+#include "Buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "VertexArrayCache.h"
+#include "Profiler.h"
+
+/*
+	Las llamadas que crean o modifican objetos pasan por estas funciones. Con DSA van por nombre y no tocan
+	lo enlazado: subir un ndice no cambia el GL_ELEMENT_ARRAY_BUFFER del VAO que est enlazado. Sin DSA
+	enlazan el buffer en "target" antes de cada llamada.
+*/
+static unsigned int CreateBuffer()
+{
+	unsigned int buffer;
+	if (g_GLCaps.DirectStateAccess)
+	{
+		GLCall(glCreateBuffers(1, &buffer));
+	}
+	else
+	{
+		GLCall(glGenBuffers(1, &buffer));
+	}
+	return buffer;
+}
+
+static void BufferData(unsigned int target, unsigned int buffer, unsigned int size, const void* data, unsigned int usage)
+{
+	if (g_GLCaps.DirectStateAccess)
+	{
+		GLCall(glNamedBufferData(buffer, size, data, usage));
+		return;
+	}
+
+	GLStateCache::BindBuffer(target, buffer);
+	GLCall(glBufferData(target, size, data, usage));
+}
+
+static void BufferSubData(unsigned int target, unsigned int buffer, unsigned int offset, unsigned int size, const void* data)
+{
+	if (g_GLCaps.DirectStateAccess)
+	{
+		GLCall(glNamedBufferSubData(buffer, offset, size, data));
+		return;
+	}
+
+	GLStateCache::BindBuffer(target, buffer);
+	GLCall(glBufferSubData(target, offset, size, data));
+}
+
+static void CopyBufferData(unsigned int readBuffer, unsigned int writeBuffer, unsigned int readOffset, unsigned int writeOffset, unsigned int size)
+{
+	if (g_GLCaps.DirectStateAccess)
+	{
+		GLCall(glCopyNamedBufferSubData(readBuffer, writeBuffer, readOffset, writeOffset, size));
+		return;
+	}
+
+	GLStateCache::BindBuffer(GL_COPY_READ_BUFFER, readBuffer);
+	GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, writeBuffer);
+	GLCall(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, readOffset, writeOffset, size));
+}
+
+Buffer::Buffer(unsigned int target)
+	: Buffer(target, nullptr, BufferUsage::Dynamic)
+{
+}
+
+Buffer::Buffer(unsigned int target, const void* data, unsigned int size, BufferUsage usage)
+	: Buffer(target, nullptr, usage)
+{
+	Allocate(data, size);
+}
+
+Buffer::Buffer(unsigned int target, BufferArena* arena, BufferUsage usage)
+	: m_RendererID(0), m_Target(target), m_Size(0), m_Usage(usage), m_Update(BufferUpdate::SubData), m_Arena(arena)
+{
+	if (!m_Arena)
+		m_RendererID = CreateBuffer();
+}
+
+Buffer::~Buffer()
+{
+	if (m_Arena)
+	{
+		m_Arena->Free(m_Allocation);
+		return;
+	}
+
+	GLCall(glDeleteBuffers(1, &m_RendererID));
+	GLStateCache::OnBufferDeleted(m_RendererID);
+	VertexArrayCache::OnBufferDeleted(m_RendererID);
+}
+
+void Buffer::Allocate(const void* data, unsigned int size)
+{
+	m_Size = size;
+
+	if (m_Arena)
+	{
+		// Si la arena no tiene lugar (ya lo inform), la vista queda vaca
+		m_Allocation = m_Arena->Allocate(size);
+		if (!m_Allocation.IsValid())
+		{
+			m_Size = 0;
+			return;
+		}
+		m_RendererID = m_Arena->GetRendererID(m_Allocation.Page);
+		if (data)
+			m_Arena->Upload(m_Allocation, data, size);
+		return;
+	}
+
+	BufferData(m_Target, m_RendererID, size, data, GetGLUsage(m_Usage));
+}
+
+unsigned int Buffer::GetGLUsage(BufferUsage usage)
+{
+	switch (usage)
+	{
+		case BufferUsage::Static:	return GL_STATIC_DRAW;
+		case BufferUsage::Dynamic:	return GL_DYNAMIC_DRAW;
+		case BufferUsage::Stream:	return GL_STREAM_DRAW;
+	}
+
+	ASSERT(false);
+	return GL_STATIC_DRAW;
+}
+
+void Buffer::BindTarget() const
+{
+	GLStateCache::BindBuffer(m_Target, m_RendererID);
+}
+
+void Buffer::SetData(const void* data, unsigned int size, unsigned int offset)
+{
+	if (size == 0)
+		return;
+
+	PROFILE_SCOPE("Buffer::SetData");
+
+	Reserve(offset + size);
+
+	// Una vista que no pudo crecer porque la arena est llena: escribir pisara a las vistas vecinas
+	if (offset + size > m_Size)
+		return;
+
+	BufferUpdate update = m_Update;
+	if (m_Arena)
+	{
+		// La pgina es de todas las vistas: hurfano quedara el contenido de las dems
+		if (update == BufferUpdate::Orphan)
+			update = BufferUpdate::SubData;
+		offset += m_Allocation.Offset;
+	}
+
+	switch (update)
+	{
+		case BufferUpdate::SubData:
+			BufferSubData(m_Target, m_RendererID, offset, size, data);
+			break;
+		case BufferUpdate::Orphan:
+			// Una escritura desde el principio empieza un contenido nuevo: el viejo queda para la GPU
+			if (offset == 0)
+				BufferData(m_Target, m_RendererID, m_Size, nullptr, GetGLUsage(m_Usage));
+			BufferSubData(m_Target, m_RendererID, offset, size, data);
+			break;
+		case BufferUpdate::MapUnsynchronized:
+		{
+			GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+			void* mapped;
+			if (g_GLCaps.DirectStateAccess)
+			{
+				GLCall(mapped = glMapNamedBufferRange(m_RendererID, offset, size, access));
+			}
+			else
+			{
+				BindTarget();
+				GLCall(mapped = glMapBufferRange(m_Target, offset, size, access));
+			}
+
+			if (!mapped)
+			{
+				// Si el driver no puede mapear, igual hay que subir los datos
+				BufferSubData(m_Target, m_RendererID, offset, size, data);
+				break;
+			}
+
+			std::memcpy(mapped, data, size);
+			if (g_GLCaps.DirectStateAccess)
+			{
+				GLCall(glUnmapNamedBuffer(m_RendererID));
+			}
+			else
+			{
+				GLCall(glUnmapBuffer(m_Target));
+			}
+			break;
+		}
+	}
+}
+
+void Buffer::Resize(unsigned int size)
+{
+	if (size == m_Size)
+		return;
+
+	PROFILE_SCOPE("Buffer::Resize");
+
+	if (m_Arena)
+	{
+		// Una vista no puede crecer en el lugar: se muda a otra asignacin y copia lo que se conserva.
+		// Si la arena no tiene lugar (ya lo inform), la vista se queda como estaba, con sus datos
+		BufferAllocation allocation = m_Arena->Allocate(size);
+		if (!allocation.IsValid())
+			return;
+
+		unsigned int page = m_Arena->GetRendererID(allocation.Page);
+		unsigned int keep = std::min(size, m_Size);
+		if (keep > 0)
+			CopyBufferData(m_RendererID, page, m_Allocation.Offset, allocation.Offset, keep);
+		m_Arena->Free(m_Allocation);
+
+		m_Allocation = allocation;
+		m_RendererID = page;
+		m_Size = size;
+		return;
+	}
+
+	// glBufferData descarta el contenido, as que lo que se conserva pasa antes por un buffer temporal
+	unsigned int keep = std::min(size, m_Size);
+	unsigned int temporary = 0;
+	if (keep > 0)
+	{
+		temporary = CreateBuffer();
+		BufferData(GL_COPY_WRITE_BUFFER, temporary, keep, nullptr, GL_STREAM_COPY);
+		CopyBufferData(m_RendererID, temporary, 0, 0, keep);
+	}
+
+	BufferData(m_Target, m_RendererID, size, nullptr, GetGLUsage(m_Usage));
+	m_Size = size;
+
+	if (temporary)
+	{
+		CopyBufferData(temporary, m_RendererID, 0, 0, keep);
+		GLCall(glDeleteBuffers(1, &temporary));
+		GLStateCache::OnBufferDeleted(temporary);
+	}
+}
+
+void Buffer::Reserve(unsigned int size)
+{
+	if (size <= m_Size)
+		return;
+
+	Resize(std::max(size, (unsigned int)(m_Size * GrowthFactor)));
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <span>
+
+#include "BufferArena.h"
+
+/// <summary>
+/// Con qu frecuencia se piensa reescribir el contenido. Se traduce a GL_STATIC_DRAW, GL_DYNAMIC_DRAW o GL_STREAM_DRAW.
+/// </summary>
+enum class BufferUsage
+{
+	// Se sube una vez y se dibuja muchas
+	Static,
+	// Se actualiza de vez en cuando, o por partes
+	Dynamic,
+	// Se reescribe entero cada frame
+	Stream
+};
+
+/// <summary>
+/// Cmo llegan los datos de SetData a la GPU:
+///		- SubData: glBufferSubData. Si la GPU todava est leyendo el buffer, el driver tiene que esperar o copiar.
+///		- Orphan: cuando la escritura empieza en 0, primero se pide almacenamiento nuevo con glBufferData(nullptr).
+///		  El driver le deja el viejo a la GPU hasta que termina de leerlo, as que no hay espera; a cambio, lo que
+///		  no se vuelva a escribir queda indefinido. Sirve para buffers que se reescriben enteros cada frame.
+///		- MapUnsynchronized: glMapBufferRange con UNSYNCHRONIZED | INVALIDATE_RANGE y una copia directa. Es lo ms
+///		  barato, pero el driver no se sincroniza con nada: quien escribe tiene que asegurarse de que la GPU no
+///		  est leyendo ese tramo (por ejemplo, escribiendo cada frame en un tramo distinto).
+/// En una vista sobre un BufferArena, Orphan se comporta como SubData: el buffer de OpenGL es compartido.
+/// </summary>
+enum class BufferUpdate
+{
+	SubData,
+	Orphan,
+	MapUnsynchronized
+};
+
+/// <summary>
+/// Parte comn de VertexBuffer e IndexBuffer: el objeto de OpenGL, su tamao y las formas de actualizarlo.
+/// El buffer puede ser dueo de su objeto de OpenGL o ser una vista sobre una asignacin de un BufferArena;
+/// en ese caso GetRendererID es la pgina de la arena y los datos empiezan en GetOffset.
+/// </summary>
+class Buffer
+{
+public:
+	// Al crecer solo, el buffer pasa a tener al menos esta proporcin del tamao anterior
+	static constexpr float GrowthFactor = 1.5f;
+
+	~Buffer();
+
+	Buffer(const Buffer&) = delete;
+	Buffer& operator=(const Buffer&) = delete;
+
+	/// <summary>
+	/// Reescribe "size" bytes a partir de "offset" con la estrategia elegida en SetUpdateStrategy. Si no entran,
+	/// el buffer crece primero (ver Reserve) conservando el contenido.
+	/// </summary>
+	void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
+	template<typename T>
+	void SetData(unsigned int offset, std::span<const T> data)
+	{
+		SetData(data.data(), (unsigned int)data.size_bytes(), offset);
+	}
+
+	/// <summary>
+	/// Cambia el tamao a exactamente "size" bytes. Los datos que entran en el tamao nuevo se conservan
+	/// con una copia en la GPU y el identificador no cambia, as que los VAO que usan el buffer siguen valiendo.
+	/// Una vista se muda a otra asignacin de la arena: ah s cambian el identificador y el offset.
+	/// </summary>
+	void Resize(unsigned int size);
+
+	// Se asegura de tener lugar para "size" bytes; si no lo hay, crece segn GrowthFactor
+	void Reserve(unsigned int size);
+
+	inline void SetUpdateStrategy(BufferUpdate update) { m_Update = update; }
+	inline BufferUpdate GetUpdateStrategy() const { return m_Update; }
+
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline unsigned int GetSize() const { return m_Size; }
+	inline BufferUsage GetUsage() const { return m_Usage; }
+
+	// Bytes desde el principio del objeto de OpenGL hasta los datos. Siempre 0 si el buffer no es una vista
+	inline unsigned int GetOffset() const { return m_Allocation.Offset; }
+	inline bool IsView() const { return m_Arena != nullptr; }
+
+	static unsigned int GetGLUsage(BufferUsage usage);
+
+protected:
+	// Identificador para todo tipo de objeto de OpenGL que asignamos a memoria
+	unsigned int m_RendererID;
+	// GL_ARRAY_BUFFER o GL_ELEMENT_ARRAY_BUFFER
+	unsigned int m_Target;
+	unsigned int m_Size;
+	BufferUsage m_Usage;
+	BufferUpdate m_Update;
+
+	// Solo en las vistas
+	BufferArena* m_Arena;
+	BufferAllocation m_Allocation;
+
+	// Solo crea el objeto de OpenGL, sin reservar memoria. Lo usan los buffers que administran su propio almacenamiento
+	Buffer(unsigned int target);
+	Buffer(unsigned int target, const void* data, unsigned int size, BufferUsage usage);
+
+	// Con "arena" el buffer es una vista y no crea nada hasta Allocate
+	Buffer(unsigned int target, BufferArena* arena, BufferUsage usage);
+
+	// Reserva "size" bytes (con glBufferData, o en la arena si es una vista) y los llena con "data" si no es nulo.
+	// Si la arena no tiene lugar, la vista queda con tamao 0
+	void Allocate(const void* data, unsigned int size);
+
+	void BindTarget() const;
+};
\ No newline at end of file
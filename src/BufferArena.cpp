@@ -0,0 +1,219 @@
+#include "BufferArena.h"
+
+#include <algorithm>
+#include <iostream>
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+#include "VertexArrayCache.h"
+#include "Profiler.h"
+
+BufferArena::BufferArena(unsigned int pageSize, unsigned int maxPages) :
+	m_PageSize(BufferArena::MinBlockSize),
+	m_MaxPages(maxPages),
+	m_LevelCount(1),
+	m_Allocations(0),
+	m_Used(0),
+	m_Requested(0)
+{
+	while (m_PageSize < pageSize)
+	{
+		m_PageSize <<= 1;
+		m_LevelCount++;
+	}
+}
+
+BufferArena::~BufferArena()
+{
+	if (m_Allocations)
+		std::cout << "BufferArena: destroyed with " << m_Allocations << " live allocations" << std::endl;
+
+	for (const Page& page : m_Pages)
+	{
+		GLCall(glDeleteBuffers(1, &page.RendererID));
+		GLStateCache::OnBufferDeleted(page.RendererID);
+		VertexArrayCache::OnBufferDeleted(page.RendererID);
+	}
+}
+
+bool BufferArena::AddPage()
+{
+	if (m_Pages.size() >= m_MaxPages)
+		return false;
+
+	PROFILE_SCOPE("BufferArena::AddPage");
+
+	Page page;
+
+	// Inmutable si se puede: el tamao no va a cambiar nunca. Los datos llegan con glBufferSubData o, si la vista
+	// usa BufferUpdate::MapUnsynchronized, mapeando su tramo
+	if (g_GLCaps.DirectStateAccess)
+	{
+		// DSA es GL 4.5, que ya incluye el almacenamiento inmutable
+		GLCall(glCreateBuffers(1, &page.RendererID));
+		GLCall(glNamedBufferStorage(page.RendererID, m_PageSize, nullptr, GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT));
+	}
+	else
+	{
+		GLCall(glGenBuffers(1, &page.RendererID));
+		GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, page.RendererID);
+		if (g_GLCaps.BufferStorage)
+		{
+			GLCall(glBufferStorage(GL_COPY_WRITE_BUFFER, m_PageSize, nullptr, GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT));
+		}
+		else
+		{
+			GLCall(glBufferData(GL_COPY_WRITE_BUFFER, m_PageSize, nullptr, GL_STATIC_DRAW));
+		}
+	}
+
+	page.FreeLists.resize(m_LevelCount);
+	page.FreeNodes.resize(((size_t)1 << m_LevelCount) - 1, false);
+	m_Pages.push_back(std::move(page));
+	PushFree(m_Pages.back(), 0, 0);
+	return true;
+}
+
+void BufferArena::PushFree(Page& page, unsigned int level, unsigned int offset)
+{
+	page.FreeLists[level].push_back(offset);
+	page.FreeNodes[GetNode(level, offset)] = true;
+}
+
+void BufferArena::RemoveFree(Page& page, unsigned int level, unsigned int offset)
+{
+	std::vector<unsigned int>& list = page.FreeLists[level];
+	auto it = std::find(list.begin(), list.end(), offset);
+	ASSERT(it != list.end());
+	*it = list.back();
+	list.pop_back();
+	page.FreeNodes[GetNode(level, offset)] = false;
+}
+
+bool BufferArena::AllocateFromPage(unsigned int pageIndex, unsigned int level, BufferAllocation& allocation)
+{
+	Page& page = m_Pages[pageIndex];
+
+	// El bloque libre ms chico que alcanza
+	int found = (int)level;
+	while (found >= 0 && page.FreeLists[found].empty())
+		found--;
+	if (found < 0)
+		return false;
+
+	unsigned int offset = page.FreeLists[found].back();
+	RemoveFree(page, found, offset);
+
+	// Se parte a la mitad hasta llegar al nivel pedido; las mitades de la derecha quedan libres
+	for (unsigned int l = found + 1; l <= level; l++)
+		PushFree(page, l, offset + GetBlockSize(l));
+
+	allocation.Page = pageIndex;
+	allocation.Offset = offset;
+	allocation.Level = level;
+	return true;
+}
+
+BufferAllocation BufferArena::Allocate(unsigned int size)
+{
+	BufferAllocation allocation;
+	if (size == 0)
+		return allocation;
+
+	if (size > m_PageSize)
+	{
+		std::cout << "BufferArena: can't allocate " << size << " bytes with " << m_PageSize << "-byte pages" << std::endl;
+		return allocation;
+	}
+
+	// Nivel ms profundo (bloque ms chico) en el que entra el pedido
+	unsigned int level = m_LevelCount - 1;
+	while (level > 0 && GetBlockSize(level) < size)
+		level--;
+
+	bool allocated = false;
+	for (unsigned int i = 0; i < m_Pages.size() && !allocated; i++)
+		allocated = AllocateFromPage(i, level, allocation);
+
+	if (!allocated && AddPage())
+		allocated = AllocateFromPage((unsigned int)m_Pages.size() - 1, level, allocation);
+
+	if (!allocated)
+	{
+		std::cout << "BufferArena: out of space for " << size << " bytes" << std::endl;
+		return BufferAllocation();
+	}
+
+	allocation.Size = size;
+	m_Allocations++;
+	m_Used += GetBlockSize(level);
+	m_Requested += size;
+	return allocation;
+}
+
+void BufferArena::Free(const BufferAllocation& allocation)
+{
+	if (!allocation.IsValid())
+		return;
+
+	Page& page = m_Pages[allocation.Page];
+	unsigned int level = allocation.Level;
+	unsigned int offset = allocation.Offset;
+	ASSERT(!page.FreeNodes[GetNode(level, offset)]);
+
+	m_Allocations--;
+	m_Used -= GetBlockSize(level);
+	m_Requested -= allocation.Size;
+
+	// Mientras el buddy tambin est libre, los dos vuelven a ser un solo bloque del nivel de arriba
+	while (level > 0)
+	{
+		unsigned int buddy = offset ^ GetBlockSize(level);
+		if (!page.FreeNodes[GetNode(level, buddy)])
+			break;
+
+		RemoveFree(page, level, buddy);
+		offset = std::min(offset, buddy);
+		level--;
+	}
+	PushFree(page, level, offset);
+}
+
+void BufferArena::Upload(const BufferAllocation& allocation, const void* data, unsigned int size, unsigned int offset)
+{
+	ASSERT(offset + size <= GetBlockSize(allocation.Level));
+
+	unsigned int page = m_Pages[allocation.Page].RendererID;
+	if (g_GLCaps.DirectStateAccess)
+	{
+		GLCall(glNamedBufferSubData(page, allocation.Offset + offset, size, data));
+		return;
+	}
+
+	GLStateCache::BindBuffer(GL_COPY_WRITE_BUFFER, page);
+	GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.Offset + offset, size, data));
+}
+
+BufferArena::Stats BufferArena::GetStats() const
+{
+	Stats stats;
+	stats.Pages = (unsigned int)m_Pages.size();
+	stats.Allocations = m_Allocations;
+	stats.Capacity = stats.Pages * m_PageSize;
+	stats.Used = m_Used;
+	stats.Requested = m_Requested;
+
+	for (const Page& page : m_Pages)
+	{
+		for (unsigned int level = 0; level < m_LevelCount; level++)
+		{
+			if (!page.FreeLists[level].empty())
+			{
+				stats.LargestFree = std::max(stats.LargestFree, GetBlockSize(level));
+				stats.ContiguousFree += GetBlockSize(level);
+				break;
+			}
+		}
+	}
+	return stats;
+}
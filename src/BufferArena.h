@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+
+/// <summary>
+/// Lugar que ocupa una asignacin dentro de un BufferArena
+/// </summary>
+struct BufferAllocation
+{
+	// ndice de la pgina (buffer de OpenGL) dentro de la arena
+	unsigned int Page = 0;
+	// Bytes desde el principio de la pgina
+	unsigned int Offset = 0;
+	// Bytes pedidos; el bloque reservado es la potencia de 2 siguiente
+	unsigned int Size = 0;
+	// Nivel del bloque en el rbol buddy: 0 es la pgina entera y cada nivel divide a la mitad
+	unsigned int Level = 0;
+
+	inline bool IsValid() const { return Size != 0; }
+};
+
+/// <summary>
+/// Memoria de GPU compartida por muchos buffers chicos. Reserva unos pocos buffers grandes e inmutables (pginas)
+/// y los reparte con un buddy allocator: cada pedido se redondea a una potencia de 2, los bloques libres se
+/// parten a la mitad hasta llegar a ese tamao y, al liberar, un bloque se vuelve a unir con su "buddy" (la
+/// otra mitad) si tambin est libre. As muchas mallas viven en un mismo buffer de OpenGL y el cach de
+/// estado se saltea los binds entre ellas.
+/// VertexBuffer e IndexBuffer se pueden crear como vistas {arena, offset, tamao} con sus constructores que
+/// reciben un BufferArena. La arena tiene que vivir ms que todas sus vistas.
+/// </summary>
+class BufferArena
+{
+public:
+	static const unsigned int DefaultPageSize = 32 * 1024 * 1024;
+	static const unsigned int DefaultMaxPages = 4;
+	// Tamao del bloque ms chico. Tambin es la alineacin de todas las asignaciones, que alcanza para
+	// cualquier tipo de vrtice o ndice
+	static const unsigned int MinBlockSize = 256;
+
+	struct Stats
+	{
+		unsigned int Pages = 0;
+		unsigned int Allocations = 0;
+		// Bytes de todas las pginas
+		unsigned int Capacity = 0;
+		// Bytes de los bloques asignados, incluyendo el redondeo a potencia de 2
+		unsigned int Used = 0;
+		// Bytes que realmente se pidieron
+		unsigned int Requested = 0;
+		// Bloque libre ms grande; lo ms que se puede pedir sin agregar una pgina
+		unsigned int LargestFree = 0;
+		// Suma del bloque libre ms grande de cada pgina. Un bloque nunca cruza pginas, as que es lo mejor posible
+		unsigned int ContiguousFree = 0;
+
+		// Fraccin de la capacidad que est asignada
+		inline float Occupancy() const { return Capacity ? (float)Used / Capacity : 0.0f; }
+		// 0 si lo libre de cada pgina est en un solo bloque; cerca de 1 si est repartido en muchos bloques chicos
+		inline float Fragmentation() const { return Capacity > Used ? 1.0f - (float)ContiguousFree / (Capacity - Used) : 0.0f; }
+		// Fraccin de lo asignado que se pierde por el redondeo
+		inline float InternalWaste() const { return Used ? 1.0f - (float)Requested / Used : 0.0f; }
+	};
+
+	/// <param name="pageSize">Bytes de cada pgina. Se redondea a una potencia de 2</param>
+	/// <param name="maxPages">Pginas que se pueden llegar a crear; se crean a medida que hacen falta</param>
+	BufferArena(unsigned int pageSize = DefaultPageSize, unsigned int maxPages = DefaultMaxPages);
+	~BufferArena();
+
+	BufferArena(const BufferArena&) = delete;
+	BufferArena& operator=(const BufferArena&) = delete;
+
+	/// <summary>
+	/// Reserva "size" bytes. Si no hay un bloque libre de ese tamao en ninguna pgina, se crea otra.
+	/// </summary>
+	/// <returns>La asignacin, o una invlida si el pedido no entra en una pgina o ya no se pueden crear ms</returns>
+	BufferAllocation Allocate(unsigned int size);
+	void Free(const BufferAllocation& allocation);
+
+	// Copia "size" bytes a partir de "offset" dentro de la asignacin
+	void Upload(const BufferAllocation& allocation, const void* data, unsigned int size, unsigned int offset = 0);
+
+	unsigned int GetRendererID(unsigned int page) const { return m_Pages[page].RendererID; }
+	inline unsigned int GetPageSize() const { return m_PageSize; }
+
+	Stats GetStats() const;
+
+private:
+	struct Page
+	{
+		unsigned int RendererID;
+		// Offsets de los bloques libres, por nivel
+		std::vector<std::vector<unsigned int>> FreeLists;
+		// Un flag por nodo del rbol: (1 << nivel) - 1 + offset / tamao del bloque
+		std::vector<bool> FreeNodes;
+	};
+
+	unsigned int m_PageSize;
+	unsigned int m_MaxPages;
+	unsigned int m_LevelCount;
+	std::vector<Page> m_Pages;
+
+	unsigned int m_Allocations;
+	unsigned int m_Used;
+	unsigned int m_Requested;
+
+	bool AddPage();
+	bool AllocateFromPage(unsigned int page, unsigned int level, BufferAllocation& allocation);
+
+	inline unsigned int GetBlockSize(unsigned int level) const { return m_PageSize >> level; }
+	inline unsigned int GetNode(unsigned int level, unsigned int offset) const { return (1u << level) - 1 + offset / GetBlockSize(level); }
+	void PushFree(Page& page, unsigned int level, unsigned int offset);
+	void RemoveFree(Page& page, unsigned int level, unsigned int offset);
+};
\ No newline at end of file
@@ -24,6 +24,11 @@ public:
 		if (!glfwInit())
 			throw new GLFWException("GLFW couldn't be initialized!");
 
+#ifdef _DEBUG
+		// Sin un contexto de depuracin, muchos drivers no envan mensajes por GL_KHR_debug
+		glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
+
 		window = glfwCreateWindow(width, height, title, NULL, NULL);
 
 		if (!window)
@@ -0,0 +1,63 @@
+#define GL_DISPATCH_NO_REDIRECT
+#include "GLDispatch.h"
+
+#include "GLMockBackend.h"
+
+GLDispatchTable g_GL = {};
+GLCapabilities g_GLCaps;
+
+static bool s_IsMock = false;
+
+void GLDispatch::UseGLEW()
+{
+	// Sin la redireccin, gl##name es el nombre de GLEW: un puntero cargado por glewInit o una funcin de GL 1.1
+#define GL_DISPATCH_LOAD(ret, name, params, args) g_GL.name = gl##name;
+	GL_DISPATCH_FUNCTIONS(GL_DISPATCH_LOAD)
+#undef GL_DISPATCH_LOAD
+
+	g_GLCaps = GLCapabilities();
+	g_GLCaps.DebugOutput = GLEW_VERSION_4_3 || GLEW_KHR_debug;
+	g_GLCaps.TimerQuery = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+	g_GLCaps.BufferStorage = GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage;
+	g_GLCaps.DrawIndirect = GLEW_VERSION_4_0 || GLEW_ARB_draw_indirect;
+	g_GLCaps.BaseInstance = GLEW_VERSION_4_2 || GLEW_ARB_base_instance;
+	g_GLCaps.MultiDrawIndirect = GLEW_VERSION_4_3 || GLEW_ARB_multi_draw_indirect;
+	g_GLCaps.DirectStateAccess = GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access;
+
+	// La versin ARB es la misma funcin con otro nombre
+	g_GLCaps.ParallelShaderCompile = GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+	if (!GLEW_KHR_parallel_shader_compile && GLEW_ARB_parallel_shader_compile)
+		g_GL.MaxShaderCompilerThreadsKHR = glMaxShaderCompilerThreadsARB;
+
+	// Hay drivers que exponen la extensin pero no aceptan ningn formato
+	if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+	{
+		GLint formats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		g_GLCaps.ProgramBinary = formats > 0;
+	}
+
+	s_IsMock = false;
+}
+
+void GLDispatch::UseMock()
+{
+	GLMockBackend::Install(g_GL, g_GLCaps);
+	s_IsMock = true;
+}
+
+bool GLDispatch::IsMock()
+{
+	return s_IsMock;
+}
+
+const char* GLFunctionName(GLFunction function)
+{
+	static const char* names[] = {
+#define GL_DISPATCH_NAME(ret, name, params, args) "gl" #name,
+		GL_DISPATCH_FUNCTIONS(GL_DISPATCH_NAME)
+#undef GL_DISPATCH_NAME
+	};
+
+	return function < GLFunction::Count ? names[(int)function] : "?";
+}
@@ -0,0 +1,381 @@
+#pragma once
+
+#include <GL/glew.h>
+
+/*
+	Lista de todas las funciones de OpenGL que usa el proyecto, con la forma
+		X(tipo de retorno, nombre sin el prefijo gl, (parmetros), (argumentos))
+	A partir de esta lista se generan la tabla de despacho, la carga desde GLEW y el backend falso,
+	as que para usar una funcin nueva alcanza con agregarla ac y abajo en los #define.
+*/
+#define GL_DISPATCH_FUNCTIONS(X) \
+	X(GLenum,			GetError,					(), ()) \
+	X(const GLubyte*,	GetString,					(GLenum name), (name)) \
+	X(void,				GetIntegerv,				(GLenum pname, GLint* data), (pname, data)) \
+	X(void,				Enable,						(GLenum cap), (cap)) \
+	X(void,				Disable,					(GLenum cap), (cap)) \
+	X(void,				Clear,						(GLbitfield mask), (mask)) \
+	X(void,				ClearColor,					(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha)) \
+	X(void,				BlendFunc,					(GLenum sfactor, GLenum dfactor), (sfactor, dfactor)) \
+	X(void,				DrawElements,				(GLenum mode, GLsizei count, GLenum type, const void* indices), (mode, count, type, indices)) \
+	X(void,				DrawElementsInstanced,		(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei primcount), (mode, count, type, indices, primcount)) \
+	X(void,				GenBuffers,					(GLsizei n, GLuint* buffers), (n, buffers)) \
+	X(void,				DeleteBuffers,				(GLsizei n, const GLuint* buffers), (n, buffers)) \
+	X(void,				BindBuffer,					(GLenum target, GLuint buffer), (target, buffer)) \
+	X(void,				BufferData,					(GLenum target, GLsizeiptr size, const void* data, GLenum usage), (target, size, data, usage)) \
+	X(void,				BufferSubData,				(GLenum target, GLintptr offset, GLsizeiptr size, const void* data), (target, offset, size, data)) \
+	X(void,				GenVertexArrays,			(GLsizei n, GLuint* arrays), (n, arrays)) \
+	X(void,				DeleteVertexArrays,			(GLsizei n, const GLuint* arrays), (n, arrays)) \
+	X(void,				BindVertexArray,			(GLuint array), (array)) \
+	X(void,				EnableVertexAttribArray,	(GLuint index), (index)) \
+	X(void,				VertexAttribPointer,		(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer), (index, size, type, normalized, stride, pointer)) \
+	X(void,				VertexAttribDivisor,		(GLuint index, GLuint divisor), (index, divisor)) \
+	X(void,				GenTextures,				(GLsizei n, GLuint* textures), (n, textures)) \
+	X(void,				DeleteTextures,				(GLsizei n, const GLuint* textures), (n, textures)) \
+	X(void,				ActiveTexture,				(GLenum texture), (texture)) \
+	X(void,				BindTexture,				(GLenum target, GLuint texture), (target, texture)) \
+	X(void,				TexParameteri,				(GLenum target, GLenum pname, GLint param), (target, pname, param)) \
+	X(void,				TexImage2D,					(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels), (target, level, internalformat, width, height, border, format, type, pixels)) \
+	X(GLuint,			CreateShader,				(GLenum type), (type)) \
+	X(void,				DeleteShader,				(GLuint shader), (shader)) \
+	X(void,				ShaderSource,				(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length), (shader, count, string, length)) \
+	X(void,				CompileShader,				(GLuint shader), (shader)) \
+	X(void,				GetShaderiv,				(GLuint shader, GLenum pname, GLint* param), (shader, pname, param)) \
+	X(void,				GetShaderInfoLog,			(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog), (shader, bufSize, length, infoLog)) \
+	X(GLuint,			CreateProgram,				(), ()) \
+	X(void,				DeleteProgram,				(GLuint program), (program)) \
+	X(void,				AttachShader,				(GLuint program, GLuint shader), (program, shader)) \
+	X(void,				LinkProgram,				(GLuint program), (program)) \
+	X(void,				ValidateProgram,			(GLuint program), (program)) \
+	X(void,				GetProgramiv,				(GLuint program, GLenum pname, GLint* param), (program, pname, param)) \
+	X(void,				UseProgram,					(GLuint program), (program)) \
+	X(GLint,			GetUniformLocation,			(GLuint program, const GLchar* name), (program, name)) \
+	X(void,				Uniform1i,					(GLint location, GLint v0), (location, v0)) \
+	X(void,				Uniform1iv,					(GLint location, GLsizei count, const GLint* value), (location, count, value)) \
+	X(void,				Uniform4f,					(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3)) \
+	X(void,				UniformMatrix4fv,			(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (location, count, transpose, value)) \
+	X(void,				DebugMessageCallback,		(GLDEBUGPROC callback, const void* userParam), (callback, userParam)) \
+	X(void,				DebugMessageControl,		(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint* ids, GLboolean enabled), (source, type, severity, count, ids, enabled)) \
+	X(void,				GenQueries,					(GLsizei n, GLuint* ids), (n, ids)) \
+	X(void,				DeleteQueries,				(GLsizei n, const GLuint* ids), (n, ids)) \
+	X(void,				BeginQuery,					(GLenum target, GLuint id), (target, id)) \
+	X(void,				EndQuery,					(GLenum target), (target)) \
+	X(void,				QueryCounter,				(GLuint id, GLenum target), (id, target)) \
+	X(void,				GetQueryObjectiv,			(GLuint id, GLenum pname, GLint* params), (id, pname, params)) \
+	X(void,				GetQueryObjectui64v,		(GLuint id, GLenum pname, GLuint64* params), (id, pname, params)) \
+	X(void,				DrawElementsBaseVertex,		(GLenum mode, GLsizei count, GLenum type, void* indices, GLint basevertex), (mode, count, type, indices, basevertex)) \
+	X(void,				BufferStorage,				(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags), (target, size, data, flags)) \
+	X(void*,			MapBufferRange,				(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access), (target, offset, length, access)) \
+	X(GLboolean,		UnmapBuffer,				(GLenum target), (target)) \
+	X(GLsync,			FenceSync,					(GLenum condition, GLbitfield flags), (condition, flags)) \
+	X(GLenum,			ClientWaitSync,				(GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout)) \
+	X(void,				DeleteSync,					(GLsync sync), (sync)) \
+	X(void,				DrawElementsIndirect,		(GLenum mode, GLenum type, const void* indirect), (mode, type, indirect)) \
+	X(void,				MultiDrawElementsIndirect,	(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride), (mode, type, indirect, drawcount, stride)) \
+	X(void,				ProgramParameteri,			(GLuint program, GLenum pname, GLint value), (program, pname, value)) \
+	X(void,				GetProgramBinary,			(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary), (program, bufSize, length, binaryFormat, binary)) \
+	X(void,				ProgramBinary,				(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length), (program, binaryFormat, binary, length)) \
+	X(void,				GetActiveUniform,			(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name)) \
+	X(void,				BindBufferBase,				(GLenum target, GLuint index, GLuint buffer), (target, index, buffer)) \
+	X(void,				BindBufferRange,			(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, index, buffer, offset, size)) \
+	X(GLuint,			GetUniformBlockIndex,		(GLuint program, const GLchar* uniformBlockName), (program, uniformBlockName)) \
+	X(void,				UniformBlockBinding,		(GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding), (program, uniformBlockIndex, uniformBlockBinding)) \
+	X(void,				GetProgramInfoLog,			(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog), (program, bufSize, length, infoLog)) \
+	X(void,				DetachShader,				(GLuint program, GLuint shader), (program, shader)) \
+	X(void,				MaxShaderCompilerThreadsKHR,	(GLuint count), (count)) \
+	X(void,				GetActiveAttrib,			(GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name), (program, index, bufSize, length, size, type, name)) \
+	X(GLint,			GetAttribLocation,			(GLuint program, const GLchar* name), (program, name)) \
+	X(void,				GetActiveUniformBlockiv,	(GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint* params), (program, uniformBlockIndex, pname, params)) \
+	X(void,				GetActiveUniformBlockName,	(GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei* length, GLchar* uniformBlockName), (program, uniformBlockIndex, bufSize, length, uniformBlockName)) \
+	X(void,				CopyBufferSubData,			(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readTarget, writeTarget, readOffset, writeOffset, size)) \
+	X(void,				CreateVertexArrays,			(GLsizei n, GLuint* arrays), (n, arrays)) \
+	X(void,				EnableVertexArrayAttrib,	(GLuint vaobj, GLuint index), (vaobj, index)) \
+	X(void,				VertexArrayAttribFormat,	(GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset), (vaobj, attribindex, size, type, normalized, relativeoffset)) \
+	X(void,				VertexArrayAttribBinding,	(GLuint vaobj, GLuint attribindex, GLuint bindingindex), (vaobj, attribindex, bindingindex)) \
+	X(void,				VertexArrayVertexBuffer,	(GLuint vaobj, GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride), (vaobj, bindingindex, buffer, offset, stride)) \
+	X(void,				VertexArrayBindingDivisor,	(GLuint vaobj, GLuint bindingindex, GLuint divisor), (vaobj, bindingindex, divisor)) \
+	X(void,				CreateBuffers,				(GLsizei n, GLuint* buffers), (n, buffers)) \
+	X(void,				NamedBufferData,			(GLuint buffer, GLsizeiptr size, const void* data, GLenum usage), (buffer, size, data, usage)) \
+	X(void,				NamedBufferSubData,			(GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data), (buffer, offset, size, data)) \
+	X(void,				NamedBufferStorage,			(GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags), (buffer, size, data, flags)) \
+	X(void*,			MapNamedBufferRange,		(GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access), (buffer, offset, length, access)) \
+	X(GLboolean,		UnmapNamedBuffer,			(GLuint buffer), (buffer)) \
+	X(void,				CopyNamedBufferSubData,		(GLuint readBuffer, GLuint writeBuffer, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readBuffer, writeBuffer, readOffset, writeOffset, size)) \
+	X(void,				CreateTextures,				(GLenum target, GLsizei n, GLuint* textures), (target, n, textures)) \
+	X(void,				TextureParameteri,			(GLuint texture, GLenum pname, GLint param), (texture, pname, param)) \
+	X(void,				TextureStorage2D,			(GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height), (texture, levels, internalformat, width, height)) \
+	X(void,				TextureSubImage2D,			(GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels), (texture, level, xoffset, yoffset, width, height, format, type, pixels)) \
+	X(void,				ProgramUniform1i,			(GLuint program, GLint location, GLint v0), (program, location, v0)) \
+	X(void,				ProgramUniform1iv,			(GLuint program, GLint location, GLsizei count, const GLint* value), (program, location, count, value)) \
+	X(void,				ProgramUniform4f,			(GLuint program, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (program, location, v0, v1, v2, v3)) \
+	X(void,				ProgramUniformMatrix4fv,	(GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), (program, location, count, transpose, value)) \
+	X(void,				DrawElementsInstancedBaseVertex,	(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instancecount, GLint basevertex), (mode, count, type, indices, instancecount, basevertex))
+
+// Identificador de cada funcin de la lista, usado por el backend falso para registrar las llamadas
+enum class GLFunction
+{
+#define GL_DISPATCH_ENUM(ret, name, params, args) name,
+	GL_DISPATCH_FUNCTIONS(GL_DISPATCH_ENUM)
+#undef GL_DISPATCH_ENUM
+	Count
+};
+
+struct GLDispatchTable
+{
+#define GL_DISPATCH_MEMBER(ret, name, params, args) ret (GLAPIENTRY* name) params;
+	GL_DISPATCH_FUNCTIONS(GL_DISPATCH_MEMBER)
+#undef GL_DISPATCH_MEMBER
+};
+
+// Extensiones y versiones opcionales que el cdigo consulta para elegir un camino u otro
+struct GLCapabilities
+{
+	// GL 4.3 o GL_KHR_debug
+	bool DebugOutput = false;
+	// GL 3.3 o GL_ARB_timer_query
+	bool TimerQuery = false;
+	// GL 4.4 o GL_ARB_buffer_storage
+	bool BufferStorage = false;
+	// GL 4.0 o GL_ARB_draw_indirect
+	bool DrawIndirect = false;
+	// GL 4.2 o GL_ARB_base_instance: sin esto, el baseInstance de los comandos indirectos tiene que ser 0
+	bool BaseInstance = false;
+	// GL 4.3 o GL_ARB_multi_draw_indirect
+	bool MultiDrawIndirect = false;
+	// GL 4.1 o GL_ARB_get_program_binary, con al menos un formato de binario soportado por el driver
+	bool ProgramBinary = false;
+	// GL_KHR_parallel_shader_compile o GL_ARB_parallel_shader_compile
+	bool ParallelShaderCompile = false;
+	// GL 4.5 o GL_ARB_direct_state_access: los objetos se configuran por nombre, sin enlazarlos
+	bool DirectStateAccess = false;
+};
+
+extern GLDispatchTable g_GL;
+extern GLCapabilities g_GLCaps;
+
+/// <summary>
+/// Elige de dnde salen las funciones de OpenGL que usan todos los wrappers. Con el backend real las llamadas
+/// van a GLEW; con el falso (GLMockBackend) no hace falta contexto, lo que permite correr y medir el costo de
+/// CPU de los tests en mquinas sin GPU.
+/// </summary>
+class GLDispatch
+{
+public:
+	// Carga la tabla con las funciones de GLEW. Hay que llamarla despus de glewInit
+	static void UseGLEW();
+	static void UseMock();
+
+	static bool IsMock();
+};
+
+const char* GLFunctionName(GLFunction function);
+
+/*
+	Todo el cdigo que incluye este archivo llama a OpenGL a travs de la tabla. GLDispatch.cpp define
+	GL_DISPATCH_NO_REDIRECT para poder ver los nombres originales de GLEW al cargarla.
+*/
+#ifndef GL_DISPATCH_NO_REDIRECT
+#undef glGetError
+#undef glGetString
+#undef glGetIntegerv
+#undef glEnable
+#undef glDisable
+#undef glClear
+#undef glClearColor
+#undef glBlendFunc
+#undef glDrawElements
+#undef glDrawElementsInstanced
+#undef glGenBuffers
+#undef glDeleteBuffers
+#undef glBindBuffer
+#undef glBufferData
+#undef glBufferSubData
+#undef glGenVertexArrays
+#undef glDeleteVertexArrays
+#undef glBindVertexArray
+#undef glEnableVertexAttribArray
+#undef glVertexAttribPointer
+#undef glVertexAttribDivisor
+#undef glGenTextures
+#undef glDeleteTextures
+#undef glActiveTexture
+#undef glBindTexture
+#undef glTexParameteri
+#undef glTexImage2D
+#undef glCreateShader
+#undef glDeleteShader
+#undef glShaderSource
+#undef glCompileShader
+#undef glGetShaderiv
+#undef glGetShaderInfoLog
+#undef glCreateProgram
+#undef glDeleteProgram
+#undef glAttachShader
+#undef glLinkProgram
+#undef glValidateProgram
+#undef glGetProgramiv
+#undef glUseProgram
+#undef glGetUniformLocation
+#undef glUniform1i
+#undef glUniform1iv
+#undef glUniform4f
+#undef glUniformMatrix4fv
+#undef glDebugMessageCallback
+#undef glDebugMessageControl
+#undef glGenQueries
+#undef glDeleteQueries
+#undef glBeginQuery
+#undef glEndQuery
+#undef glQueryCounter
+#undef glGetQueryObjectiv
+#undef glGetQueryObjectui64v
+#undef glDrawElementsBaseVertex
+#undef glBufferStorage
+#undef glMapBufferRange
+#undef glUnmapBuffer
+#undef glFenceSync
+#undef glClientWaitSync
+#undef glDeleteSync
+#undef glDrawElementsIndirect
+#undef glMultiDrawElementsIndirect
+#undef glProgramParameteri
+#undef glGetProgramBinary
+#undef glProgramBinary
+#undef glGetActiveUniform
+#undef glBindBufferBase
+#undef glBindBufferRange
+#undef glGetUniformBlockIndex
+#undef glUniformBlockBinding
+#undef glGetProgramInfoLog
+#undef glDetachShader
+#undef glMaxShaderCompilerThreadsKHR
+#undef glGetActiveAttrib
+#undef glGetAttribLocation
+#undef glGetActiveUniformBlockiv
+#undef glGetActiveUniformBlockName
+#undef glCopyBufferSubData
+#undef glCreateVertexArrays
+#undef glEnableVertexArrayAttrib
+#undef glVertexArrayAttribFormat
+#undef glVertexArrayAttribBinding
+#undef glVertexArrayVertexBuffer
+#undef glVertexArrayBindingDivisor
+#undef glCreateBuffers
+#undef glNamedBufferData
+#undef glNamedBufferSubData
+#undef glNamedBufferStorage
+#undef glMapNamedBufferRange
+#undef glUnmapNamedBuffer
+#undef glCopyNamedBufferSubData
+#undef glCreateTextures
+#undef glTextureParameteri
+#undef glTextureStorage2D
+#undef glTextureSubImage2D
+#undef glProgramUniform1i
+#undef glProgramUniform1iv
+#undef glProgramUniform4f
+#undef glProgramUniformMatrix4fv
+#undef glDrawElementsInstancedBaseVertex
+
+#define glGetError					g_GL.GetError
+#define glGetString					g_GL.GetString
+#define glGetIntegerv				g_GL.GetIntegerv
+#define glEnable					g_GL.Enable
+#define glDisable					g_GL.Disable
+#define glClear						g_GL.Clear
+#define glClearColor				g_GL.ClearColor
+#define glBlendFunc					g_GL.BlendFunc
+#define glDrawElements				g_GL.DrawElements
+#define glDrawElementsInstanced		g_GL.DrawElementsInstanced
+#define glGenBuffers				g_GL.GenBuffers
+#define glDeleteBuffers				g_GL.DeleteBuffers
+#define glBindBuffer				g_GL.BindBuffer
+#define glBufferData				g_GL.BufferData
+#define glBufferSubData				g_GL.BufferSubData
+#define glGenVertexArrays			g_GL.GenVertexArrays
+#define glDeleteVertexArrays		g_GL.DeleteVertexArrays
+#define glBindVertexArray			g_GL.BindVertexArray
+#define glEnableVertexAttribArray	g_GL.EnableVertexAttribArray
+#define glVertexAttribPointer		g_GL.VertexAttribPointer
+#define glVertexAttribDivisor		g_GL.VertexAttribDivisor
+#define glGenTextures				g_GL.GenTextures
+#define glDeleteTextures			g_GL.DeleteTextures
+#define glActiveTexture				g_GL.ActiveTexture
+#define glBindTexture				g_GL.BindTexture
+#define glTexParameteri				g_GL.TexParameteri
+#define glTexImage2D				g_GL.TexImage2D
+#define glCreateShader				g_GL.CreateShader
+#define glDeleteShader				g_GL.DeleteShader
+#define glShaderSource				g_GL.ShaderSource
+#define glCompileShader				g_GL.CompileShader
+#define glGetShaderiv				g_GL.GetShaderiv
+#define glGetShaderInfoLog			g_GL.GetShaderInfoLog
+#define glCreateProgram				g_GL.CreateProgram
+#define glDeleteProgram				g_GL.DeleteProgram
+#define glAttachShader				g_GL.AttachShader
+#define glLinkProgram				g_GL.LinkProgram
+#define glValidateProgram			g_GL.ValidateProgram
+#define glGetProgramiv				g_GL.GetProgramiv
+#define glUseProgram				g_GL.UseProgram
+#define glGetUniformLocation		g_GL.GetUniformLocation
+#define glUniform1i					g_GL.Uniform1i
+#define glUniform1iv				g_GL.Uniform1iv
+#define glUniform4f					g_GL.Uniform4f
+#define glUniformMatrix4fv			g_GL.UniformMatrix4fv
+#define glDebugMessageCallback		g_GL.DebugMessageCallback
+#define glDebugMessageControl		g_GL.DebugMessageControl
+#define glGenQueries				g_GL.GenQueries
+#define glDeleteQueries				g_GL.DeleteQueries
+#define glBeginQuery				g_GL.BeginQuery
+#define glEndQuery					g_GL.EndQuery
+#define glQueryCounter				g_GL.QueryCounter
+#define glGetQueryObjectiv			g_GL.GetQueryObjectiv
+#define glGetQueryObjectui64v		g_GL.GetQueryObjectui64v
+#define glDrawElementsBaseVertex	g_GL.DrawElementsBaseVertex
+#define glBufferStorage				g_GL.BufferStorage
+#define glMapBufferRange			g_GL.MapBufferRange
+#define glUnmapBuffer				g_GL.UnmapBuffer
+#define glFenceSync					g_GL.FenceSync
+#define glClientWaitSync			g_GL.ClientWaitSync
+#define glDeleteSync				g_GL.DeleteSync
+#define glDrawElementsIndirect		g_GL.DrawElementsIndirect
+#define glMultiDrawElementsIndirect	g_GL.MultiDrawElementsIndirect
+#define glProgramParameteri			g_GL.ProgramParameteri
+#define glGetProgramBinary			g_GL.GetProgramBinary
+#define glProgramBinary				g_GL.ProgramBinary
+#define glGetActiveUniform			g_GL.GetActiveUniform
+#define glBindBufferBase			g_GL.BindBufferBase
+#define glBindBufferRange			g_GL.BindBufferRange
+#define glGetUniformBlockIndex		g_GL.GetUniformBlockIndex
+#define glUniformBlockBinding		g_GL.UniformBlockBinding
+#define glGetProgramInfoLog			g_GL.GetProgramInfoLog
+#define glDetachShader				g_GL.DetachShader
+#define glMaxShaderCompilerThreadsKHR	g_GL.MaxShaderCompilerThreadsKHR
+#define glGetActiveAttrib			g_GL.GetActiveAttrib
+#define glGetAttribLocation			g_GL.GetAttribLocation
+#define glGetActiveUniformBlockiv	g_GL.GetActiveUniformBlockiv
+#define glGetActiveUniformBlockName	g_GL.GetActiveUniformBlockName
+#define glCopyBufferSubData			g_GL.CopyBufferSubData
+#define glCreateVertexArrays		g_GL.CreateVertexArrays
+#define glEnableVertexArrayAttrib	g_GL.EnableVertexArrayAttrib
+#define glVertexArrayAttribFormat	g_GL.VertexArrayAttribFormat
+#define glVertexArrayAttribBinding	g_GL.VertexArrayAttribBinding
+#define glVertexArrayVertexBuffer	g_GL.VertexArrayVertexBuffer
+#define glVertexArrayBindingDivisor	g_GL.VertexArrayBindingDivisor
+#define glCreateBuffers				g_GL.CreateBuffers
+#define glNamedBufferData			g_GL.NamedBufferData
+#define glNamedBufferSubData		g_GL.NamedBufferSubData
+#define glNamedBufferStorage		g_GL.NamedBufferStorage
+#define glMapNamedBufferRange		g_GL.MapNamedBufferRange
+#define glUnmapNamedBuffer			g_GL.UnmapNamedBuffer
+#define glCopyNamedBufferSubData	g_GL.CopyNamedBufferSubData
+#define glCreateTextures			g_GL.CreateTextures
+#define glTextureParameteri			g_GL.TextureParameteri
+#define glTextureStorage2D			g_GL.TextureStorage2D
+#define glTextureSubImage2D			g_GL.TextureSubImage2D
+#define glProgramUniform1i			g_GL.ProgramUniform1i
+#define glProgramUniform1iv			g_GL.ProgramUniform1iv
+#define glProgramUniform4f			g_GL.ProgramUniform4f
+#define glProgramUniformMatrix4fv	g_GL.ProgramUniformMatrix4fv
+#define glDrawElementsInstancedBaseVertex	g_GL.DrawElementsInstancedBaseVertex
+#endif
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "GLMockBackend.h"
+
+#include <cstdint>
+#include <memory>
+
+static std::vector<GLFunction> s_Calls;
+static std::array<unsigned long long, (size_t)GLFunction::Count> s_TotalCalls = {};
+
+// Los identificadores arrancan en 1 porque 0 significa "ningn objeto" en OpenGL
+static GLuint s_NextObjectID = 1;
+
+// Memoria devuelta por MapBufferRange. Los mapeos persistentes se liberan recin al terminar el programa
+struct MockMapping
+{
+	std::unique_ptr<char[]> Memory;
+	GLenum Target;
+	// Buffer de los mapeos con MapNamedBufferRange, que no pasan por un target
+	GLuint Buffer;
+	bool Persistent;
+};
+static std::vector<MockMapping> s_MappedMemory;
+
+static void Record(GLFunction function)
+{
+	s_Calls.push_back(function);
+	s_TotalCalls[(size_t)function]++;
+}
+
+// Los stubs no miran sus argumentos; pasarlos por ac evita un aviso por cada parmetro sin usar
+template<typename... Args>
+static void IgnoreArguments(const Args&...)
+{
+}
+
+template<typename T>
+static T MockResult()
+{
+	return T();
+}
+
+/*
+	Una funcin falsa por cada funcin de la lista, que solo registra la llamada y devuelve el valor por defecto
+	del tipo. Las que tienen que devolver algo con sentido se reemplazan ms abajo en Install.
+*/
+#define GL_MOCK_FUNCTION(ret, name, params, args) \
+	static ret GLAPIENTRY Mock##name params { Record(GLFunction::name); IgnoreArguments args; return MockResult<ret>(); }
+GL_DISPATCH_FUNCTIONS(GL_MOCK_FUNCTION)
+#undef GL_MOCK_FUNCTION
+
+static void GenObjects(GLsizei n, GLuint* objects)
+{
+	for (GLsizei i = 0; i < n; i++)
+		objects[i] = s_NextObjectID++;
+}
+
+static void GLAPIENTRY MockGenBuffersImpl(GLsizei n, GLuint* buffers)
+{
+	Record(GLFunction::GenBuffers);
+	GenObjects(n, buffers);
+}
+
+static void GLAPIENTRY MockCreateBuffersImpl(GLsizei n, GLuint* buffers)
+{
+	Record(GLFunction::CreateBuffers);
+	GenObjects(n, buffers);
+}
+
+static void GLAPIENTRY MockGenVertexArraysImpl(GLsizei n, GLuint* arrays)
+{
+	Record(GLFunction::GenVertexArrays);
+	GenObjects(n, arrays);
+}
+
+static void GLAPIENTRY MockCreateVertexArraysImpl(GLsizei n, GLuint* arrays)
+{
+	Record(GLFunction::CreateVertexArrays);
+	GenObjects(n, arrays);
+}
+
+static void GLAPIENTRY MockGenTexturesImpl(GLsizei n, GLuint* textures)
+{
+	Record(GLFunction::GenTextures);
+	GenObjects(n, textures);
+}
+
+static void GLAPIENTRY MockCreateTexturesImpl(GLenum /*target*/, GLsizei n, GLuint* textures)
+{
+	Record(GLFunction::CreateTextures);
+	GenObjects(n, textures);
+}
+
+static GLuint GLAPIENTRY MockCreateShaderImpl(GLenum /*type*/)
+{
+	Record(GLFunction::CreateShader);
+	return s_NextObjectID++;
+}
+
+static GLuint GLAPIENTRY MockCreateProgramImpl()
+{
+	Record(GLFunction::CreateProgram);
+	return s_NextObjectID++;
+}
+
+static void GetObjectParameter(GLenum pname, GLint* param)
+{
+	// Compilar y enlazar siempre sale bien, y nunca hay log
+	switch (pname)
+	{
+		case GL_COMPILE_STATUS:
+		case GL_LINK_STATUS:
+		case GL_VALIDATE_STATUS:
+		case GL_COMPLETION_STATUS_KHR:
+			*param = GL_TRUE;
+			break;
+		default:
+			*param = 0;
+			break;
+	}
+}
+
+static void GLAPIENTRY MockGetShaderivImpl(GLuint /*shader*/, GLenum pname, GLint* param)
+{
+	Record(GLFunction::GetShaderiv);
+	GetObjectParameter(pname, param);
+}
+
+static void GLAPIENTRY MockGetProgramivImpl(GLuint /*program*/, GLenum pname, GLint* param)
+{
+	Record(GLFunction::GetProgramiv);
+	GetObjectParameter(pname, param);
+}
+
+static void GLAPIENTRY MockGetIntegervImpl(GLenum /*pname*/, GLint* data)
+{
+	Record(GLFunction::GetIntegerv);
+	*data = 0;
+}
+
+static const GLubyte* GLAPIENTRY MockGetStringImpl(GLenum /*name*/)
+{
+	Record(GLFunction::GetString);
+	return (const GLubyte*)"Mock";
+}
+
+static void GLAPIENTRY MockGenQueriesImpl(GLsizei n, GLuint* ids)
+{
+	Record(GLFunction::GenQueries);
+	GenObjects(n, ids);
+}
+
+static void GLAPIENTRY MockGetQueryObjectivImpl(GLuint /*id*/, GLenum pname, GLint* params)
+{
+	// Los resultados estn siempre disponibles, as el profiler no descarta frames
+	Record(GLFunction::GetQueryObjectiv);
+	*params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+static void GLAPIENTRY MockGetQueryObjectui64vImpl(GLuint /*id*/, GLenum /*pname*/, GLuint64* params)
+{
+	Record(GLFunction::GetQueryObjectui64v);
+	*params = 0;
+}
+
+static void* GLAPIENTRY MockMapBufferRangeImpl(GLenum target, GLintptr /*offset*/, GLsizeiptr length, GLbitfield access)
+{
+	// Memoria de verdad, para que quien escribe en el buffer mapeado no se entere de que no hay GPU
+	Record(GLFunction::MapBufferRange);
+	s_MappedMemory.push_back({ std::unique_ptr<char[]>(new char[length]), target, 0, (access & GL_MAP_PERSISTENT_BIT) != 0 });
+	return s_MappedMemory.back().Memory.get();
+}
+
+static GLboolean GLAPIENTRY MockUnmapBufferImpl(GLenum target)
+{
+	// Los mapeos de cada frame se liberan enseguida, si no un benchmark que mapea mucho se queda sin memoria
+	Record(GLFunction::UnmapBuffer);
+	for (size_t i = s_MappedMemory.size(); i-- > 0; )
+	{
+		if (s_MappedMemory[i].Target == target && !s_MappedMemory[i].Persistent)
+		{
+			s_MappedMemory.erase(s_MappedMemory.begin() + i);
+			break;
+		}
+	}
+	return GL_TRUE;
+}
+
+static void* GLAPIENTRY MockMapNamedBufferRangeImpl(GLuint buffer, GLintptr /*offset*/, GLsizeiptr length, GLbitfield access)
+{
+	Record(GLFunction::MapNamedBufferRange);
+	s_MappedMemory.push_back({ std::unique_ptr<char[]>(new char[length]), 0, buffer, (access & GL_MAP_PERSISTENT_BIT) != 0 });
+	return s_MappedMemory.back().Memory.get();
+}
+
+static GLboolean GLAPIENTRY MockUnmapNamedBufferImpl(GLuint buffer)
+{
+	Record(GLFunction::UnmapNamedBuffer);
+	for (size_t i = s_MappedMemory.size(); i-- > 0; )
+	{
+		if (s_MappedMemory[i].Buffer == buffer && !s_MappedMemory[i].Persistent)
+		{
+			s_MappedMemory.erase(s_MappedMemory.begin() + i);
+			break;
+		}
+	}
+	return GL_TRUE;
+}
+
+static GLsync GLAPIENTRY MockFenceSyncImpl(GLenum /*condition*/, GLbitfield /*flags*/)
+{
+	Record(GLFunction::FenceSync);
+	return (GLsync)(uintptr_t)s_NextObjectID++;
+}
+
+static GLenum GLAPIENTRY MockClientWaitSyncImpl(GLsync /*sync*/, GLbitfield /*flags*/, GLuint64 /*timeout*/)
+{
+	// La GPU falsa nunca se atrasa
+	Record(GLFunction::ClientWaitSync);
+	return GL_ALREADY_SIGNALED;
+}
+
+static GLint GLAPIENTRY MockGetUniformLocationImpl(GLuint /*program*/, const GLchar* /*name*/)
+{
+	// Cualquier valor distinto de -1 sirve para que los shaders no avisen de uniforms inexistentes
+	Record(GLFunction::GetUniformLocation);
+	return 0;
+}
+
+void GLMockBackend::Install(GLDispatchTable& table, GLCapabilities& caps)
+{
+#define GL_MOCK_INSTALL(ret, name, params, args) table.name = Mock##name;
+	GL_DISPATCH_FUNCTIONS(GL_MOCK_INSTALL)
+#undef GL_MOCK_INSTALL
+
+	table.GenBuffers = MockGenBuffersImpl;
+	table.CreateBuffers = MockCreateBuffersImpl;
+	table.GenVertexArrays = MockGenVertexArraysImpl;
+	table.CreateVertexArrays = MockCreateVertexArraysImpl;
+	table.GenTextures = MockGenTexturesImpl;
+	table.CreateTextures = MockCreateTexturesImpl;
+	table.CreateShader = MockCreateShaderImpl;
+	table.CreateProgram = MockCreateProgramImpl;
+	table.GetShaderiv = MockGetShaderivImpl;
+	table.GetProgramiv = MockGetProgramivImpl;
+	table.GetIntegerv = MockGetIntegervImpl;
+	table.GetString = MockGetStringImpl;
+	table.GetUniformLocation = MockGetUniformLocationImpl;
+	table.GenQueries = MockGenQueriesImpl;
+	table.GetQueryObjectiv = MockGetQueryObjectivImpl;
+	table.GetQueryObjectui64v = MockGetQueryObjectui64vImpl;
+	table.MapBufferRange = MockMapBufferRangeImpl;
+	table.UnmapBuffer = MockUnmapBufferImpl;
+	table.MapNamedBufferRange = MockMapNamedBufferRangeImpl;
+	table.UnmapNamedBuffer = MockUnmapNamedBufferImpl;
+	table.FenceSync = MockFenceSyncImpl;
+	table.ClientWaitSync = MockClientWaitSyncImpl;
+
+	caps = GLCapabilities();
+	caps.DebugOutput = true;
+	caps.TimerQuery = true;
+	caps.BufferStorage = true;
+	caps.DrawIndirect = true;
+	caps.BaseInstance = true;
+	caps.MultiDrawIndirect = true;
+	caps.ProgramBinary = true;
+	caps.ParallelShaderCompile = true;
+	caps.DirectStateAccess = true;
+}
+
+void GLMockBackend::ResetCalls()
+{
+	s_Calls.clear();
+}
+
+const std::vector<GLFunction>& GLMockBackend::GetCalls()
+{
+	return s_Calls;
+}
+
+unsigned long long GLMockBackend::GetTotalCallCount(GLFunction function)
+{
+	return s_TotalCalls[(size_t)function];
+}
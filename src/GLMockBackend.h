@@ -0,0 +1,25 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "GLDispatch.h"
+
+/// <summary>
+/// Backend de OpenGL que no dibuja nada. Registra cada llamada que recibe y devuelve identificadores falsos
+/// para los objetos que se crean, de modo que los wrappers y los tests funcionan igual que con un contexto real.
+/// </summary>
+class GLMockBackend
+{
+public:
+	// Llena la tabla con las funciones falsas. Las capacidades se reportan todas como disponibles
+	static void Install(GLDispatchTable& table, GLCapabilities& caps);
+
+	// Olvida las llamadas registradas hasta ahora (los contadores totales no se tocan)
+	static void ResetCalls();
+
+	// Llamadas registradas desde el ltimo ResetCalls, en orden
+	static const std::vector<GLFunction>& GetCalls();
+
+	static unsigned long long GetTotalCallCount(GLFunction function);
+};
\ No newline at end of file
@@ -0,0 +1,190 @@
+#include "GLStateCache.h"
+
+#include <array>
+
+#include "Renderer.h"
+
+// Valor que no puede tener ningn objeto ni enum, usado para "estado desconocido"
+static const unsigned int s_Unknown = 0xffffffff;
+
+static unsigned int s_Program = s_Unknown;
+static unsigned int s_VertexArray = s_Unknown;
+static unsigned int s_ArrayBuffer = s_Unknown;
+// El GL_ELEMENT_ARRAY_BUFFER es parte del estado del VAO, as que se olvida cada vez que cambia el VAO
+static unsigned int s_ElementArrayBuffer = s_Unknown;
+static unsigned int s_ActiveTexture = s_Unknown;
+static std::array<unsigned int, GLStateCache::MaxTextureUnits> s_TextureUnits = []()
+{
+	std::array<unsigned int, GLStateCache::MaxTextureUnits> units;
+	units.fill(s_Unknown);
+	return units;
+}();
+static unsigned int s_Blend = s_Unknown;
+static unsigned int s_BlendSrc = s_Unknown;
+static unsigned int s_BlendDst = s_Unknown;
+
+static GLStateCache::Stats s_CurrentStats;
+static GLStateCache::Stats s_FrameStats;
+
+bool GLStateCache::Changed(unsigned int& cached, unsigned int value)
+{
+	if (cached == value)
+	{
+		s_CurrentStats.Hits++;
+		return false;
+	}
+
+	s_CurrentStats.Misses++;
+	cached = value;
+	return true;
+}
+
+void GLStateCache::UseProgram(unsigned int program)
+{
+	if (Changed(s_Program, program))
+	{
+		GLCall(glUseProgram(program));
+	}
+}
+
+void GLStateCache::BindVertexArray(unsigned int vao)
+{
+	if (Changed(s_VertexArray, vao))
+	{
+		GLCall(glBindVertexArray(vao));
+		s_ElementArrayBuffer = s_Unknown;
+	}
+}
+
+void GLStateCache::BindBuffer(unsigned int target, unsigned int buffer)
+{
+	switch (target)
+	{
+		case GL_ARRAY_BUFFER:
+			if (Changed(s_ArrayBuffer, buffer))
+			{
+				GLCall(glBindBuffer(target, buffer));
+			}
+			break;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			if (Changed(s_ElementArrayBuffer, buffer))
+			{
+				GLCall(glBindBuffer(target, buffer));
+			}
+			break;
+		default:
+			s_CurrentStats.Misses++;
+			GLCall(glBindBuffer(target, buffer));
+			break;
+	}
+}
+
+void GLStateCache::ActiveTexture(unsigned int unit)
+{
+	if (Changed(s_ActiveTexture, unit))
+	{
+		GLCall(glActiveTexture(GL_TEXTURE0 + unit));
+	}
+}
+
+void GLStateCache::BindTexture(unsigned int unit, unsigned int target, unsigned int texture)
+{
+	ASSERT(unit < MaxTextureUnits);
+
+	// Si la textura ya est en esa unidad no hace falta ni siquiera cambiar la unidad activa
+	if (s_TextureUnits[unit] == texture)
+	{
+		s_CurrentStats.Hits++;
+		return;
+	}
+
+	ActiveTexture(unit);
+	Changed(s_TextureUnits[unit], texture);
+	GLCall(glBindTexture(target, texture));
+}
+
+void GLStateCache::SetBlend(bool enabled)
+{
+	if (Changed(s_Blend, enabled ? 1 : 0))
+	{
+		if (enabled)
+		{
+			GLCall(glEnable(GL_BLEND));
+		}
+		else
+		{
+			GLCall(glDisable(GL_BLEND));
+		}
+	}
+}
+
+void GLStateCache::BlendFunc(unsigned int sfactor, unsigned int dfactor)
+{
+	if (s_BlendSrc == sfactor && s_BlendDst == dfactor)
+	{
+		s_CurrentStats.Hits++;
+		return;
+	}
+
+	s_CurrentStats.Misses++;
+	s_BlendSrc = sfactor;
+	s_BlendDst = dfactor;
+	GLCall(glBlendFunc(sfactor, dfactor));
+}
+
+void GLStateCache::OnProgramDeleted(unsigned int program)
+{
+	// Un programa en uso no se borra hasta dejar de usarse, pero para la cach da igual: se vuelve a enlazar cuando haga falta
+	if (s_Program == program)
+		s_Program = s_Unknown;
+}
+
+void GLStateCache::OnVertexArrayDeleted(unsigned int vao)
+{
+	if (s_VertexArray == vao)
+	{
+		s_VertexArray = 0;
+		s_ElementArrayBuffer = s_Unknown;
+	}
+}
+
+void GLStateCache::OnBufferDeleted(unsigned int buffer)
+{
+	if (s_ArrayBuffer == buffer)
+		s_ArrayBuffer = 0;
+	if (s_ElementArrayBuffer == buffer)
+		s_ElementArrayBuffer = 0;
+}
+
+void GLStateCache::OnTextureDeleted(unsigned int texture)
+{
+	for (unsigned int i = 0; i < MaxTextureUnits; i++)
+	{
+		if (s_TextureUnits[i] == texture)
+			s_TextureUnits[i] = 0;
+	}
+}
+
+void GLStateCache::Invalidate()
+{
+	s_Program = s_Unknown;
+	s_VertexArray = s_Unknown;
+	s_ArrayBuffer = s_Unknown;
+	s_ElementArrayBuffer = s_Unknown;
+	s_ActiveTexture = s_Unknown;
+	s_TextureUnits.fill(s_Unknown);
+	s_Blend = s_Unknown;
+	s_BlendSrc = s_Unknown;
+	s_BlendDst = s_Unknown;
+}
+
+void GLStateCache::NewFrame()
+{
+	s_FrameStats = s_CurrentStats;
+	s_CurrentStats = Stats();
+}
+
+const GLStateCache::Stats& GLStateCache::GetFrameStats()
+{
+	return s_FrameStats;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+/// <summary>
+/// Cach del estado de OpenGL del contexto. Todos los wrappers (Shader, VertexArray, VertexBuffer,
+/// IndexBuffer y Texture) enlazan sus objetos a travs de esta clase, que recuerda qu est enlazado
+/// y se saltea las llamadas que no cambiaran nada.
+/// </summary>
+class GLStateCache
+{
+public:
+	static const unsigned int MaxTextureUnits = 32;
+
+	struct Stats
+	{
+		// Llamadas evitadas porque el estado ya era el pedido
+		unsigned int Hits = 0;
+		// Llamadas que s llegaron al driver
+		unsigned int Misses = 0;
+	};
+
+	static void UseProgram(unsigned int program);
+	static void BindVertexArray(unsigned int vao);
+
+	// Solo se cachean GL_ARRAY_BUFFER y GL_ELEMENT_ARRAY_BUFFER; el resto de los targets pasa directo
+	static void BindBuffer(unsigned int target, unsigned int buffer);
+
+	static void ActiveTexture(unsigned int unit);
+	static void BindTexture(unsigned int unit, unsigned int target, unsigned int texture);
+
+	static void SetBlend(bool enabled);
+	static void BlendFunc(unsigned int sfactor, unsigned int dfactor);
+
+	/*
+		Al borrar un objeto, OpenGL lo desenlaza solo de los puntos en los que estaba enlazado.
+		Estas funciones reflejan eso en la cach para que un nuevo objeto con el mismo id no se saltee.
+	*/
+	static void OnProgramDeleted(unsigned int program);
+	static void OnVertexArrayDeleted(unsigned int vao);
+	static void OnBufferDeleted(unsigned int buffer);
+	static void OnTextureDeleted(unsigned int texture);
+
+	// Marca todo el estado como desconocido. Hay que llamarla despus de cdigo que usa OpenGL sin pasar por ac (por ejemplo ImGui)
+	static void Invalidate();
+
+	// Cierra las estadsticas del frame actual y empieza a contar las del siguiente
+	static void NewFrame();
+	static const Stats& GetFrameStats();
+
+private:
+	static bool Changed(unsigned int& cached, unsigned int value);
+};
\ No newline at end of file
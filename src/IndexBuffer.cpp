@@ -1,28 +1,120 @@
 #include "IndexBuffer.h"
 
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
 #include "Renderer.h"
+#include "GLStateCache.h"
+
+static std::vector<uint16_t> Narrow(const uint32_t* data, unsigned int count)
+{
+    std::vector<uint16_t> narrow(count);
+    std::transform(data, data + count, narrow.begin(), [](uint32_t index) { return (uint16_t)index; });
+    return narrow;
+}
+
+IndexBuffer::IndexBuffer(const uint32_t* data, unsigned int count, BufferUsage usage)
+    : IndexBuffer(nullptr, data, count, usage)
+{
+}
+
+IndexBuffer::IndexBuffer(const uint16_t* data, unsigned int count, BufferUsage usage)
+    : IndexBuffer(nullptr, data, count, usage)
+{
+}
+
+IndexBuffer::IndexBuffer(BufferArena& arena, const uint32_t* data, unsigned int count)
+    : IndexBuffer(&arena, data, count, BufferUsage::Static)
+{
+}
+
+IndexBuffer::IndexBuffer(BufferArena& arena, const uint16_t* data, unsigned int count)
+    : IndexBuffer(&arena, data, count, BufferUsage::Static)
+{
+}
 
-IndexBuffer::IndexBuffer(const unsigned int* data, unsigned int count)
-    : m_Count(count)
+IndexBuffer::IndexBuffer(BufferArena* arena, const uint32_t* data, unsigned int count, BufferUsage usage)
+    : Buffer(GL_ELEMENT_ARRAY_BUFFER, arena, usage), m_Count(count)
 {
-    ASSERT(sizeof(unsigned int) == sizeof(GLuint));
+    m_Type = ChooseType(count ? *std::max_element(data, data + count) : 0);
 
-    GLCall(glGenBuffers(1, &m_RendererID));
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID));
-    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW));
+    if (m_Type == IndexType::UInt16)
+    {
+        std::vector<uint16_t> narrow = Narrow(data, count);
+        Allocate(narrow.data(), count * sizeof(uint16_t));
+    }
+    else
+    {
+        Allocate(data, count * sizeof(uint32_t));
+    }
+}
+
+IndexBuffer::IndexBuffer(BufferArena* arena, const uint16_t* data, unsigned int count, BufferUsage usage)
+    : Buffer(GL_ELEMENT_ARRAY_BUFFER, arena, usage), m_Count(count), m_Type(IndexType::UInt16)
+{
+    Allocate(data, count * sizeof(uint16_t));
+}
+
+IndexBuffer::IndexBuffer(unsigned int count, unsigned int maxIndex, BufferUsage usage)
+    : Buffer(GL_ELEMENT_ARRAY_BUFFER, nullptr, usage), m_Count(count), m_Type(ChooseType(maxIndex))
+{
+    Allocate(nullptr, count * GetIndexSize());
+}
+
+IndexType IndexBuffer::ChooseType(unsigned int maxIndex)
+{
+    return maxIndex <= MaxIndex16 ? IndexType::UInt16 : IndexType::UInt32;
+}
+
+unsigned int IndexBuffer::GetType() const
+{
+    return m_Type == IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+void IndexBuffer::SetData(const uint32_t* data, unsigned int count, unsigned int offset)
+{
+    if (m_Type == IndexType::UInt16)
+    {
+        // El buffer no se ensancha solo: quien lo cre prometi que los ndices entraban en 16 bits.
+        // Si no entran se rechaza toda la llamada, tambin en Release, en vez de truncarlos y dibujar basura
+        unsigned int maxIndex = count ? *std::max_element(data, data + count) : 0;
+        if (maxIndex > MaxIndex16)
+        {
+            std::cout << "IndexBuffer: index " << maxIndex << " doesn't fit in a 16-bit buffer, ignoring SetData of "
+                << count << " indices" << std::endl;
+            return;
+        }
+        std::vector<uint16_t> narrow = Narrow(data, count);
+        Buffer::SetData(narrow.data(), count * sizeof(uint16_t), offset * sizeof(uint16_t));
+    }
+    else
+    {
+        Buffer::SetData(data, count * sizeof(uint32_t), offset * sizeof(uint32_t));
+    }
+    m_Count = std::max(m_Count, offset + count);
 }
 
-IndexBuffer::~IndexBuffer()
+void IndexBuffer::SetData(const uint16_t* data, unsigned int count, unsigned int offset)
 {
-    GLCall(glDeleteBuffers(1, &m_RendererID));
+    if (m_Type == IndexType::UInt32)
+    {
+        std::vector<uint32_t> wide(data, data + count);
+        Buffer::SetData(wide.data(), count * sizeof(uint32_t), offset * sizeof(uint32_t));
+    }
+    else
+    {
+        Buffer::SetData(data, count * sizeof(uint16_t), offset * sizeof(uint16_t));
+    }
+    m_Count = std::max(m_Count, offset + count);
 }
 
 void IndexBuffer::Bind() const
 {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
 }
 
 void IndexBuffer::Unbind() const
 {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GLStateCache::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
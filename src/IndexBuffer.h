@@ -1,18 +1,82 @@
 #pragma once
 
-class IndexBuffer
+#include <cstdint>
+
+#include "Buffer.h"
+
+/// <summary>
+/// Ancho de cada ndice dentro del buffer
+/// </summary>
+enum class IndexType
+{
+	UInt16,
+	UInt32
+};
+
+/// <summary>
+/// Index Buffer que guarda los ndices con el tipo ms angosto que alcanza: si ningn ndice pasa de 65535 se
+/// guardan como uint16_t, que ocupa la mitad de memoria y de ancho de banda. Los draws tienen que usar GetType()
+/// en lugar de suponer GL_UNSIGNED_INT.
+/// </summary>
+class IndexBuffer : public Buffer
 {
 private:
-	// Identificador para todo tipo de objeto de OpenGL que asignamos a memoria
-	unsigned int m_RendererID;
 	unsigned int m_Count;
+	IndexType m_Type;
+
+	IndexBuffer(BufferArena* arena, const uint32_t* data, unsigned int count, BufferUsage usage);
+	IndexBuffer(BufferArena* arena, const uint16_t* data, unsigned int count, BufferUsage usage);
 
 public:
-	IndexBuffer(const unsigned int* data, unsigned int count);
-	~IndexBuffer();
+	// ndice ms grande que entra en un buffer de 16 bits
+	static const unsigned int MaxIndex16 = 0xFFFF;
+
+	// El tipo se elige segn el ndice ms grande de "data"
+	IndexBuffer(const uint32_t* data, unsigned int count, BufferUsage usage = BufferUsage::Static);
+	IndexBuffer(const uint16_t* data, unsigned int count, BufferUsage usage = BufferUsage::Static);
+
+	// Vistas dentro de "arena". Los draws tienen que pasar GetDrawOffset como puntero a los ndices
+	IndexBuffer(BufferArena& arena, const uint32_t* data, unsigned int count);
+	IndexBuffer(BufferArena& arena, const uint16_t* data, unsigned int count);
+
+	/// <summary>
+	/// Crea un buffer vaco con lugar para "count" ndices, pensado para ser llenado por partes con SetData.
+	/// Como todava no hay datos, el tipo se elige con "maxIndex": el ndice ms grande que se va a escribir.
+	/// </summary>
+	IndexBuffer(unsigned int count, unsigned int maxIndex, BufferUsage usage = BufferUsage::Dynamic);
+
+	/// <summary>
+	/// Reescribe "count" ndices a partir del ndice "offset". Si se pasa del final, el buffer crece
+	/// y la cantidad de ndices a dibujar pasa a incluirlos. Los datos se convierten al tipo del buffer;
+	/// en un buffer de 16 bits ningn ndice puede pasar de MaxIndex16: si alguno pasa, no se escribe nada.
+	/// </summary>
+	void SetData(const uint32_t* data, unsigned int count, unsigned int offset = 0);
+	void SetData(const uint16_t* data, unsigned int count, unsigned int offset = 0);
+
+	void SetData(unsigned int offset, std::span<const uint32_t> indices)
+	{
+		SetData(indices.data(), (unsigned int)indices.size(), offset);
+	}
+
+	void SetData(unsigned int offset, std::span<const uint16_t> indices)
+	{
+		SetData(indices.data(), (unsigned int)indices.size(), offset);
+	}
 
 	void Bind() const;
 	void Unbind() const;
 
 	inline unsigned int GetCount() const { return m_Count; }
+	inline IndexType GetIndexType() const { return m_Type; }
+
+	// GL_UNSIGNED_SHORT o GL_UNSIGNED_INT, para pasarle a glDrawElements y compaa
+	unsigned int GetType() const;
+
+	// El ltimo parmetro de glDrawElements: dnde empiezan los ndices dentro del buffer enlazado
+	inline const void* GetDrawOffset() const { return (const void*)(uintptr_t)GetOffset(); }
+
+	// Bytes por ndice
+	inline unsigned int GetIndexSize() const { return m_Type == IndexType::UInt16 ? 2 : 4; }
+
+	static IndexType ChooseType(unsigned int maxIndex);
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "MeshPool.h"
+
+#include "Renderer.h"
+#include "shapes/Shape.h"
+
+MeshPool::MeshPool(const VertexBufferLayout& layout, unsigned int maxVertices, unsigned int maxIndices) :
+	m_InstanceBuffer(nullptr),
+	m_InstanceBinding(0),
+	m_FirstInstance(0),
+	m_Stride(layout.GetStride()),
+	m_MaxVertices(maxVertices),
+	m_MaxIndices(maxIndices),
+	m_VertexCount(0),
+	m_IndexCount(0)
+{
+	m_VAO = std::make_unique<VertexArray>();
+	m_VertexBuffer = std::make_unique<VertexBuffer>(maxVertices * m_Stride);
+	m_VAO->AddBuffer(*m_VertexBuffer, layout);
+	// Los ndices son relativos al primer vrtice de cada malla, as que nunca pasan de maxVertices
+	m_IndexBuffer = std::make_unique<IndexBuffer>(maxIndices, maxVertices - 1);
+}
+
+MeshPool::~MeshPool()
+{
+}
+
+void MeshPool::SetInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout)
+{
+	ASSERT(!m_InstanceBuffer);
+
+	m_InstanceBuffer = &vb;
+	m_InstanceBinding = m_VAO->GetBindingCount();
+	m_VAO->AddBuffer(vb, layout);
+}
+
+void MeshPool::SetFirstInstance(unsigned int firstInstance) const
+{
+	if (firstInstance == m_FirstInstance)
+		return;
+
+	// Sin buffer por instancia no hay nada que correr
+	ASSERT(m_InstanceBuffer);
+	m_VAO->SetBuffer(m_InstanceBinding, *m_InstanceBuffer, firstInstance * m_VAO->GetBindingStride(m_InstanceBinding));
+	m_FirstInstance = firstInstance;
+}
+
+MeshHandle MeshPool::Add(const void* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount)
+{
+	if (m_VertexCount + vertexCount > m_MaxVertices || m_IndexCount + indexCount > m_MaxIndices)
+	{
+		ASSERT(false);
+		return MeshHandle();
+	}
+
+	MeshHandle mesh;
+	mesh.IndexCount = indexCount;
+	mesh.FirstIndex = m_IndexCount;
+	mesh.BaseVertex = (int)m_VertexCount;
+
+	m_VertexBuffer->SetData(vertices, vertexCount * m_Stride, m_VertexCount * m_Stride);
+	m_IndexBuffer->SetData(indices, indexCount, m_IndexCount);
+
+	m_VertexCount += vertexCount;
+	m_IndexCount += indexCount;
+	return mesh;
+}
+
+MeshHandle MeshPool::Add(const Shape& shape)
+{
+	ASSERT(m_Stride == 2 * sizeof(float));
+
+	return Add(shape.GetPositions(), shape.GetVertices(), shape.GetIndexes(), 3 * shape.GetTriangles());
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "VertexBufferLayout.h"
+
+class Shape;
+
+// Ubicacin de una malla dentro de los buffers del pool. Es lo que necesita un comando de dibujo indirecto
+struct MeshHandle
+{
+	unsigned int IndexCount = 0;
+	// Primer ndice de la malla dentro del Index Buffer del pool
+	unsigned int FirstIndex = 0;
+	// Se suma a cada ndice, as los ndices de la malla siguen empezando en 0
+	int BaseVertex = 0;
+};
+
+/// <summary>
+/// Guarda muchas mallas con el mismo formato de vrtice en un solo Vertex Buffer y un solo Index Buffer,
+/// de modo que todas comparten VAO y se pueden dibujar juntas con Renderer::DrawIndirect.
+/// Los rangos se reparten uno detrs del otro y no se liberan por separado: el pool se descarta entero.
+/// </summary>
+class MeshPool
+{
+public:
+	MeshPool(const VertexBufferLayout& layout, unsigned int maxVertices, unsigned int maxIndices);
+	~MeshPool();
+
+	/// <summary>
+	/// Copia una malla al pool
+	/// </summary>
+	/// <param name="vertices">Vrtices con el formato del layout del pool</param>
+	/// <param name="indices">ndices relativos al primer vrtice de la malla</param>
+	/// <returns>Dnde qued la malla. Si no hay lugar, un handle con IndexCount en 0</returns>
+	MeshHandle Add(const void* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount);
+
+	// Agrega una figura. El layout del pool tiene que ser solo la posicin, como 2 floats
+	MeshHandle Add(const Shape& shape);
+
+	/// <summary>
+	/// Asocia al VAO del pool el buffer con los datos por instancia. Renderer::DrawIndirect lo usa para
+	/// dibujar cada malla desde su propio tramo cuando el driver no soporta baseInstance.
+	/// </summary>
+	void SetInstanceBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+
+	// Hace que la instancia 0 lea los datos de "firstInstance" en el buffer por instancia
+	void SetFirstInstance(unsigned int firstInstance) const;
+
+	// VAO con el Vertex Buffer del pool ya asociado
+	inline VertexArray& GetVertexArray() { return *m_VAO; }
+	inline const VertexArray& GetVertexArray() const { return *m_VAO; }
+	inline const IndexBuffer& GetIndexBuffer() const { return *m_IndexBuffer; }
+
+	inline unsigned int GetVertexCount() const { return m_VertexCount; }
+	inline unsigned int GetIndexCount() const { return m_IndexCount; }
+
+private:
+	std::unique_ptr<VertexArray> m_VAO;
+	std::unique_ptr<VertexBuffer> m_VertexBuffer;
+	std::unique_ptr<IndexBuffer> m_IndexBuffer;
+
+	// El buffer por instancia no es del pool; es de quien llam a SetInstanceBuffer
+	const VertexBuffer* m_InstanceBuffer;
+	unsigned int m_InstanceBinding;
+	// Instancia a la que apunta ahora el punto de enlace del buffer por instancia
+	mutable unsigned int m_FirstInstance;
+
+	unsigned int m_Stride;
+	unsigned int m_MaxVertices;
+	unsigned int m_MaxIndices;
+	unsigned int m_VertexCount;
+	unsigned int m_IndexCount;
+};
\ No newline at end of file
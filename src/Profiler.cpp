@@ -0,0 +1,363 @@
+#include "Profiler.h"
+
+#include <chrono>
+#include <deque>
+#include <fstream>
+
+#include "Renderer.h"
+
+#include "imgui/imgui.h"
+
+struct GpuZoneQueries
+{
+	const char* Name;
+	unsigned int Depth;
+	// ndices dentro de QuerySlot::Queries
+	unsigned int Begin;
+	unsigned int End;
+};
+
+// Consultas de un frame. Hay QueryRingSize de estos y se reutilizan en orden
+struct QuerySlot
+{
+	std::vector<unsigned int> Queries;
+	unsigned int Used = 0;
+	unsigned int FrameQuery = 0;
+	std::vector<GpuZoneQueries> Zones;
+	unsigned long long FrameIndex = 0;
+	bool Pending = false;
+};
+
+static QuerySlot s_Slots[Profiler::QueryRingSize];
+static std::deque<ProfileFrame> s_History;
+static ProfileFrame s_Current;
+static bool s_InFrame = false;
+static unsigned int s_Depth = 0;
+static unsigned int s_GpuDepth = 0;
+static unsigned long long s_FrameIndex = 0;
+static unsigned long long s_DroppedFrames = 0;
+
+static unsigned int AcquireQuery(QuerySlot& slot)
+{
+	if (slot.Used == slot.Queries.size())
+	{
+		unsigned int query;
+		GLCall(glGenQueries(1, &query));
+		slot.Queries.push_back(query);
+	}
+	return slot.Used++;
+}
+
+static bool IsQueryAvailable(unsigned int query)
+{
+	GLint available = 0;
+	GLCall(glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available));
+	return available != 0;
+}
+
+static GLuint64 GetQueryResult(unsigned int query)
+{
+	GLuint64 result = 0;
+	GLCall(glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result));
+	return result;
+}
+
+static ProfileFrame* FindFrame(unsigned long long index)
+{
+	if (s_History.empty() || index < s_History.front().Index || index > s_History.back().Index)
+		return nullptr;
+	return &s_History[(size_t)(index - s_History.front().Index)];
+}
+
+// Lee los resultados de un frame anterior solo si ya estn listos; nunca espera a la GPU
+static bool TryResolve(QuerySlot& slot)
+{
+	// Las consultas terminan en el orden en que se enviaron, as que alcanza con mirar las ltimas
+	if (!IsQueryAvailable(slot.FrameQuery) || !IsQueryAvailable(slot.Queries[slot.Used - 1]))
+		return false;
+
+	slot.Pending = false;
+
+	ProfileFrame* frame = FindFrame(slot.FrameIndex);
+	if (!frame)
+		return true;
+
+	frame->GpuTime = GetQueryResult(slot.FrameQuery) / 1000.0;
+
+	// La primera consulta del slot es el timestamp de inicio del frame
+	GLuint64 frameBegin = GetQueryResult(slot.Queries[0]);
+	for (const GpuZoneQueries& zone : slot.Zones)
+	{
+		if (zone.End == 0)
+			continue;
+
+		double start = (double)(GetQueryResult(slot.Queries[zone.Begin]) - frameBegin) / 1000.0;
+		double end = (double)(GetQueryResult(slot.Queries[zone.End]) - frameBegin) / 1000.0;
+		frame->Zones.push_back({ zone.Name, frame->Start + start, frame->Start + end, zone.Depth, true });
+	}
+
+	return true;
+}
+
+double Profiler::Now()
+{
+	static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::BeginFrame()
+{
+	s_Current = ProfileFrame();
+	s_Current.Index = s_FrameIndex;
+	s_Current.Start = Now();
+	s_Depth = 0;
+	s_GpuDepth = 0;
+	s_InFrame = true;
+
+	if (!g_GLCaps.TimerQuery)
+		return;
+
+	QuerySlot& slot = s_Slots[s_FrameIndex % QueryRingSize];
+	if (slot.Pending && !TryResolve(slot))
+	{
+		// La GPU va ms de QueryRingSize frames atrasada: antes que esperarla, se pierden esos resultados
+		slot.Pending = false;
+		s_DroppedFrames++;
+	}
+
+	slot.Used = 0;
+	slot.Zones.clear();
+	slot.FrameIndex = s_FrameIndex;
+	slot.Pending = true;
+
+	if (!slot.FrameQuery)
+	{
+		GLCall(glGenQueries(1, &slot.FrameQuery));
+	}
+	GLCall(glBeginQuery(GL_TIME_ELAPSED, slot.FrameQuery));
+
+	unsigned int frameBegin = AcquireQuery(slot);
+	GLCall(glQueryCounter(slot.Queries[frameBegin], GL_TIMESTAMP));
+}
+
+void Profiler::EndFrame()
+{
+	if (!s_InFrame)
+		return;
+
+	if (g_GLCaps.TimerQuery)
+	{
+		GLCall(glEndQuery(GL_TIME_ELAPSED));
+	}
+
+	s_Current.End = Now();
+	s_History.push_back(std::move(s_Current));
+	if (s_History.size() > MaxHistory)
+		s_History.pop_front();
+
+	s_InFrame = false;
+	s_FrameIndex++;
+
+	if (!g_GLCaps.TimerQuery)
+		return;
+
+	for (QuerySlot& slot : s_Slots)
+	{
+		if (slot.Pending)
+			TryResolve(slot);
+	}
+}
+
+int Profiler::BeginZone(const char* name)
+{
+	if (!s_InFrame)
+		return -1;
+
+	s_Current.Zones.push_back({ name, Now(), 0.0, s_Depth++, false });
+	return (int)s_Current.Zones.size() - 1;
+}
+
+void Profiler::EndZone(int zone)
+{
+	if (!s_InFrame || zone < 0 || zone >= (int)s_Current.Zones.size())
+		return;
+
+	s_Current.Zones[zone].End = Now();
+	s_Depth--;
+}
+
+int Profiler::BeginGpuZone(const char* name)
+{
+	if (!s_InFrame || !g_GLCaps.TimerQuery)
+		return -1;
+
+	QuerySlot& slot = s_Slots[s_FrameIndex % QueryRingSize];
+	unsigned int begin = AcquireQuery(slot);
+	GLCall(glQueryCounter(slot.Queries[begin], GL_TIMESTAMP));
+
+	slot.Zones.push_back({ name, s_GpuDepth++, begin, 0 });
+	return (int)slot.Zones.size() - 1;
+}
+
+void Profiler::EndGpuZone(int zone)
+{
+	if (!s_InFrame || !g_GLCaps.TimerQuery || zone < 0)
+		return;
+
+	QuerySlot& slot = s_Slots[s_FrameIndex % QueryRingSize];
+	if (zone >= (int)slot.Zones.size())
+		return;
+
+	unsigned int end = AcquireQuery(slot);
+	GLCall(glQueryCounter(slot.Queries[end], GL_TIMESTAMP));
+
+	slot.Zones[zone].End = end;
+	s_GpuDepth--;
+}
+
+static ImU32 ZoneColor(const char* name, bool gpu)
+{
+	// El mismo nombre tiene siempre el mismo color, para poder seguir una zona entre frames
+	unsigned int hash = 2166136261u;
+	for (const char* c = name; *c; c++)
+		hash = (hash ^ (unsigned char)*c) * 16777619u;
+
+	float hue = (hash % 360) / 360.0f;
+	float r, g, b;
+	ImGui::ColorConvertHSVtoRGB(hue, gpu ? 0.45f : 0.6f, gpu ? 0.75f : 0.85f, r, g, b);
+	return ImGui::ColorConvertFloat4ToU32(ImVec4(r, g, b, 1.0f));
+}
+
+void Profiler::OnImGuiRender()
+{
+	ImGui::Begin("Profiler");
+
+	if (s_History.empty())
+	{
+		ImGui::Text("No frames recorded yet");
+		ImGui::End();
+		return;
+	}
+
+	// Se muestra el frame ms reciente que ya tenga los tiempos de GPU, as ambas pistas estn completas
+	const ProfileFrame* frame = GetLastGpuFrame();
+	if (!frame)
+		frame = &s_History.back();
+
+	double frameDuration = frame->End - frame->Start;
+	ImGui::Text("Frame %llu: CPU %.3f ms, GPU %.3f ms", frame->Index, frameDuration / 1000.0,
+		frame->GpuTime >= 0.0 ? frame->GpuTime / 1000.0 : 0.0);
+	if (!g_GLCaps.TimerQuery)
+		ImGui::Text("GPU timer queries not supported");
+	else if (s_DroppedFrames)
+		ImGui::Text("GPU results dropped for %llu frame(s)", s_DroppedFrames);
+
+	// Lnea de tiempo: una fila por nivel de anidamiento, primero las zonas de CPU y debajo las de GPU
+	unsigned int cpuRows = 0, gpuRows = 0;
+	for (const ProfileZone& zone : frame->Zones)
+	{
+		unsigned int& rows = zone.Gpu ? gpuRows : cpuRows;
+		if (zone.Depth + 1 > rows)
+			rows = zone.Depth + 1;
+	}
+
+	const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+	ImVec2 origin = ImGui::GetCursorScreenPos();
+	float width = ImGui::GetContentRegionAvail().x;
+	float height = rowHeight * (cpuRows + gpuRows + 1);
+	double scale = frameDuration > 0.0 ? width / frameDuration : 0.0;
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+	drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + height), IM_COL32(30, 30, 30, 255));
+	ImGui::InvisibleButton("timeline", ImVec2(width, height));
+	ImVec2 mouse = ImGui::GetIO().MousePos;
+	bool hovered = ImGui::IsItemHovered();
+
+	for (const ProfileZone& zone : frame->Zones)
+	{
+		float row = (float)(zone.Gpu ? cpuRows + 1 + zone.Depth : zone.Depth);
+		ImVec2 min(origin.x + (float)((zone.Start - frame->Start) * scale), origin.y + row * rowHeight);
+		ImVec2 max(origin.x + (float)((zone.End - frame->Start) * scale), min.y + rowHeight - 1.0f);
+		if (max.x - min.x < 1.0f)
+			max.x = min.x + 1.0f;
+
+		drawList->AddRectFilled(min, max, ZoneColor(zone.Name, zone.Gpu));
+		if (ImGui::CalcTextSize(zone.Name).x < max.x - min.x - 4.0f)
+			drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32(0, 0, 0, 255), zone.Name);
+
+		if (hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y)
+			ImGui::SetTooltip("%s (%s): %.3f ms", zone.Name, zone.Gpu ? "GPU" : "CPU", (zone.End - zone.Start) / 1000.0);
+	}
+
+	static int captureFrames = 120;
+	static bool lastCaptureOk = true;
+	ImGui::InputInt("Frames", &captureFrames);
+	if (captureFrames < 1)
+		captureFrames = 1;
+	if (ImGui::Button("Save Chrome trace"))
+		lastCaptureOk = WriteChromeTrace("profile_trace.json", captureFrames);
+	if (!lastCaptureOk)
+		ImGui::Text("Couldn't write profile_trace.json");
+
+	ImGui::End();
+}
+
+const ProfileFrame* Profiler::GetLastGpuFrame()
+{
+	for (auto it = s_History.rbegin(); it != s_History.rend(); ++it)
+	{
+		if (it->GpuTime >= 0.0)
+			return &*it;
+	}
+	return nullptr;
+}
+
+// Escribe "text" como contenido de un string JSON: comillas, barras y caracteres de control van escapados
+static void WriteJsonString(std::ostream& stream, const char* text)
+{
+	static const char hex[] = "0123456789abcdef";
+	for (const char* c = text; *c; c++)
+	{
+		unsigned char ch = (unsigned char)*c;
+		if (ch == '"' || ch == '\\')
+			stream << '\\' << *c;
+		else if (ch < 0x20)
+			stream << "\\u00" << hex[ch >> 4] << hex[ch & 0xf];
+		else
+			stream << *c;
+	}
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path, unsigned int frames)
+{
+	std::ofstream stream(path);
+	if (!stream)
+		return false;
+
+	size_t first = s_History.size() > frames ? s_History.size() - frames : 0;
+
+	// tid 1 son las zonas de CPU y tid 2 las de GPU, cada una en su propia pista
+	stream << "{\"traceEvents\":[\n";
+	stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n";
+	stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+	stream.precision(3);
+	stream << std::fixed;
+	for (size_t i = first; i < s_History.size(); i++)
+	{
+		const ProfileFrame& frame = s_History[i];
+		stream << ",\n{\"name\":\"Frame " << frame.Index << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" <<
+			frame.Start << ",\"dur\":" << frame.End - frame.Start << "}";
+
+		for (const ProfileZone& zone : frame.Zones)
+		{
+			stream << ",\n{\"name\":\"";
+			WriteJsonString(stream, zone.Name);
+			stream << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << (zone.Gpu ? 2 : 1) <<
+				",\"ts\":" << zone.Start << ",\"dur\":" << zone.End - zone.Start << "}";
+		}
+	}
+	stream << "\n]}\n";
+
+	return (bool)stream;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+	Zonas de profiling. Se abren al construir el objeto y se cierran al salir del scope:
+		PROFILE_SCOPE("nombre")		mide tiempo de CPU con un reloj monotnico
+		PROFILE_GPU_SCOPE("nombre")	mide tiempo de GPU con consultas GL_TIMESTAMP
+	Fuera de Profiler::BeginFrame/EndFrame no registran nada, as que se pueden dejar en cualquier parte.
+*/
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(name) GpuProfileScope PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
+
+struct ProfileZone
+{
+	const char* Name;
+	// Microsegundos desde que arranc el profiler. Las zonas de GPU se alinean con el inicio del frame en CPU
+	double Start;
+	double End;
+	unsigned int Depth;
+	bool Gpu;
+};
+
+struct ProfileFrame
+{
+	unsigned long long Index = 0;
+	double Start = 0.0;
+	double End = 0.0;
+	// Tiempo total de GPU del frame medido con GL_TIME_ELAPSED, o -1 si todava no se ley
+	double GpuTime = -1.0;
+	std::vector<ProfileZone> Zones;
+};
+
+/// <summary>
+/// Profiler de frames. Las consultas de GPU se guardan en un anillo de varios frames y se leen recin cuando
+/// OpenGL avisa que estn listas, as que leer los resultados nunca frena al pipeline. Si despus de dar la vuelta
+/// al anillo siguen sin estar listas, se descartan.
+/// </summary>
+class Profiler
+{
+public:
+	// Cantidad de frames en vuelo que puede tener la GPU antes de descartar sus consultas
+	static const unsigned int QueryRingSize = 4;
+	// Cantidad de frames completos que se guardan para el overlay y para exportar
+	static const unsigned int MaxHistory = 300;
+
+	static void BeginFrame();
+	static void EndFrame();
+
+	static void OnImGuiRender();
+
+	/// <summary>
+	/// Escribe los ltimos "frames" frames completos en formato Chrome trace (chrome://tracing o Perfetto)
+	/// </summary>
+	/// <returns>false si no se pudo abrir el archivo</returns>
+	static bool WriteChromeTrace(const std::string& path, unsigned int frames);
+
+	/// <summary>
+	/// El frame ms reciente que ya tiene los tiempos de GPU ledos
+	/// </summary>
+	/// <returns>nullptr si todava no hay ninguno</returns>
+	static const ProfileFrame* GetLastGpuFrame();
+
+	// Usadas por ProfileScope y GpuProfileScope
+	static int BeginZone(const char* name);
+	static void EndZone(int zone);
+	static int BeginGpuZone(const char* name);
+	static void EndGpuZone(int zone);
+
+	static double Now();
+};
+
+class ProfileScope
+{
+private:
+	int m_Zone;
+
+public:
+	ProfileScope(const char* name) : m_Zone(Profiler::BeginZone(name)) {}
+	~ProfileScope() { Profiler::EndZone(m_Zone); }
+};
+
+class GpuProfileScope
+{
+private:
+	int m_Zone;
+
+public:
+	GpuProfileScope(const char* name) : m_Zone(Profiler::BeginGpuZone(name)) {}
+	~GpuProfileScope() { Profiler::EndGpuZone(m_Zone); }
+};
\ No newline at end of file
@@ -1,14 +1,35 @@
 #include "Renderer.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+#include "GLStateCache.h"
+#include "Profiler.h"
+#include "VertexBufferLayout.h"
+#include "StreamingVertexBuffer.h"
+#include "MeshPool.h"
+#include "UniformBuffer.h"
+#include "Texture.h"
+#include "ShaderLibrary.h"
+
+// Hasta que se instale el callback con GLSetErrorCheckLevel, el mejor nivel disponible es el chequeo por llamada
+static GLErrorCheckLevel s_ErrorCheckLevel = GL_ERROR_CHECK >= GL_ERROR_CHECK_PER_CALL ?
+    GLErrorCheckLevel::PerCall : (GLErrorCheckLevel)GL_ERROR_CHECK;
+
 void GLClearError()
 {
+    if (s_ErrorCheckLevel != GLErrorCheckLevel::PerCall)
+        return;
+
     while (glGetError() != GL_NO_ERROR);
 }
 
 bool GLLogCall(const char* function, const char* file, int line)
 {
+    if (s_ErrorCheckLevel != GLErrorCheckLevel::PerCall)
+        return true;
+
     while (GLenum error = glGetError())
     {
         std::cout << "[OpenGL Error] (" << error << "): " << function <<
@@ -18,6 +39,171 @@ bool GLLogCall(const char* function, const char* file, int line)
     return true;
 }
 
+#if GL_ERROR_CHECK >= GL_ERROR_CHECK_DEBUG_OUTPUT
+static const char* GLDebugSourceName(GLenum source)
+{
+    switch (source)
+    {
+        case GL_DEBUG_SOURCE_API:               return "API";
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM:     return "Window system";
+        case GL_DEBUG_SOURCE_SHADER_COMPILER:   return "Shader compiler";
+        case GL_DEBUG_SOURCE_THIRD_PARTY:       return "Third party";
+        case GL_DEBUG_SOURCE_APPLICATION:       return "Application";
+    }
+    return "Other";
+}
+
+static const char* GLDebugSeverityName(GLenum severity)
+{
+    switch (severity)
+    {
+        case GL_DEBUG_SEVERITY_HIGH:            return "High";
+        case GL_DEBUG_SEVERITY_MEDIUM:          return "Medium";
+        case GL_DEBUG_SEVERITY_LOW:             return "Low";
+    }
+    return "Notification";
+}
+
+static void GLAPIENTRY GLDebugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity,
+    GLsizei /*length*/, const GLchar* message, const void* /*userParam*/)
+{
+    std::cout << "[OpenGL Debug] (" << GLDebugSourceName(source) << ", " << GLDebugSeverityName(severity) <<
+        ", " << id << "): " << message << std::endl;
+
+    // La salida es sincrnica, as que la pila de llamadas apunta a la llamada que fall
+    if (type == GL_DEBUG_TYPE_ERROR)
+        DEBUG_BREAK();
+}
+#endif
+
+void GLSetErrorCheckLevel(GLErrorCheckLevel level)
+{
+    if ((int)level > GL_ERROR_CHECK)
+        level = (GLErrorCheckLevel)GL_ERROR_CHECK;
+
+#if GL_ERROR_CHECK >= GL_ERROR_CHECK_DEBUG_OUTPUT
+    bool debugOutputSupported = g_GLCaps.DebugOutput;
+    if (level == GLErrorCheckLevel::DebugOutput && !debugOutputSupported)
+        level = GLErrorCheckLevel::PerCall;
+
+    if (debugOutputSupported)
+    {
+        if (level == GLErrorCheckLevel::DebugOutput)
+        {
+            glEnable(GL_DEBUG_OUTPUT);
+            glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+            glDebugMessageCallback(GLDebugMessageCallback, nullptr);
+        }
+        else
+        {
+            glDisable(GL_DEBUG_OUTPUT);
+            glDebugMessageCallback(nullptr, nullptr);
+        }
+    }
+#endif
+
+    s_ErrorCheckLevel = level;
+
+    // Se descartan los errores que hayan quedado del nivel anterior para no atriburselos a la prxima llamada
+    if (level != GLErrorCheckLevel::Off)
+        while (glGetError() != GL_NO_ERROR);
+}
+
+GLErrorCheckLevel GLGetErrorCheckLevel()
+{
+    return s_ErrorCheckLevel;
+}
+
+void GLSetDebugMessageFilter(unsigned int source, unsigned int minSeverity)
+{
+#if GL_ERROR_CHECK >= GL_ERROR_CHECK_DEBUG_OUTPUT
+    if (!g_GLCaps.DebugOutput)
+        return;
+
+    // Las severidades de menor a mayor. Se apaga todo y se vuelven a encender las que pasan el filtro
+    static const GLenum severities[] = {
+        GL_DEBUG_SEVERITY_NOTIFICATION, GL_DEBUG_SEVERITY_LOW, GL_DEBUG_SEVERITY_MEDIUM, GL_DEBUG_SEVERITY_HIGH
+    };
+
+    // Con un valor que no es ninguna severidad el filtro apagara todo; mejor mostrar de ms que perder errores
+    if (std::find(std::begin(severities), std::end(severities), minSeverity) == std::end(severities))
+    {
+        std::cout << "Warning: unknown debug severity 0x" << std::hex << minSeverity << std::dec << ", showing every message" << std::endl;
+        minSeverity = GL_DEBUG_SEVERITY_NOTIFICATION;
+    }
+
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+
+    bool enabled = false;
+    for (GLenum severity : severities)
+    {
+        enabled = enabled || severity == minSeverity;
+        if (enabled)
+            glDebugMessageControl(source, GL_DONT_CARE, severity, 0, nullptr, GL_TRUE);
+    }
+#else
+    (void)source;
+    (void)minSeverity;
+#endif
+}
+
+void GLCheckFrameErrors()
+{
+#if GL_ERROR_CHECK >= GL_ERROR_CHECK_PER_FRAME
+    if (s_ErrorCheckLevel != GLErrorCheckLevel::PerFrame)
+        return;
+
+    unsigned int count = 0;
+    GLenum first = GL_NO_ERROR;
+    while (GLenum error = glGetError())
+    {
+        if (count++ == 0)
+            first = error;
+    }
+
+    if (count > 0)
+    {
+        std::cout << "[OpenGL Error] " << count << " error(s) during the frame, first (" << first <<
+            "). Switch to per-call checking to find the call." << std::endl;
+    }
+#endif
+}
+
+// UBO del bloque "Camera", compartido por todos los Renderer y todos los programas
+static std::unique_ptr<UniformBuffer> s_CameraBuffer;
+
+Renderer::Renderer() :
+    m_IndirectBuffer(0),
+    m_IndirectCapacity(0),
+    m_ObjectCapacity(0),
+    m_ObjectRingIndex(0)
+{
+}
+
+Renderer::~Renderer()
+{
+    if (m_IndirectBuffer)
+    {
+        GLCall(glDeleteBuffers(1, &m_IndirectBuffer));
+        GLStateCache::OnBufferDeleted(m_IndirectBuffer);
+    }
+}
+
+void Renderer::BeginScene(const glm::mat4& view, const glm::mat4& projection)
+{
+    if (!s_CameraBuffer)
+        s_CameraBuffer = std::make_unique<UniformBuffer>((unsigned int)sizeof(CameraData));
+
+    CameraData camera = { projection * view, view, projection };
+    s_CameraBuffer->SetData(&camera, sizeof(camera));
+    s_CameraBuffer->BindBase(UniformBuffer::CameraBinding);
+}
+
+void Renderer::Shutdown()
+{
+    s_CameraBuffer.reset();
+}
+
 void Renderer::Clear()
 {
     GLCall(glClear(GL_COLOR_BUFFER_BIT));
@@ -25,10 +211,460 @@ void Renderer::Clear()
 
 void Renderer::Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const
 {
+    PROFILE_SCOPE("Renderer::Draw");
+    PROFILE_GPU_SCOPE("Renderer::Draw");
+
+    va.Validate(shader);
     shader.Bind();
     va.Bind();
     ib.Bind();
 
     /* Dibujo los tringulos. El segundo parmetro cuenta realmente los vrtices, es decir, los pares (x,y) de cada vrtice. */
-    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
+    GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), ib.GetType(), ib.GetDrawOffset()));
+}
+
+void Renderer::DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const
+{
+    PROFILE_SCOPE("Renderer::DrawInstanced");
+    PROFILE_GPU_SCOPE("Renderer::DrawInstanced");
+
+    va.Validate(shader);
+    shader.Bind();
+    va.Bind();
+    ib.Bind();
+
+    GLCall(glDrawElementsInstanced(GL_TRIANGLES, ib.GetCount(), ib.GetType(), ib.GetDrawOffset(), instanceCount));
+}
+
+void Renderer::DrawIndirect(const MeshPool& pool, const Shader& shader, const IndirectDraw* draws, unsigned int count)
+{
+    if (count == 0)
+        return;
+
+    PROFILE_SCOPE("Renderer::DrawIndirect");
+    PROFILE_GPU_SCOPE("Renderer::DrawIndirect");
+
+    // Si el Index Buffer del pool es una vista, sus ndices no empiezan al principio del buffer enlazado
+    const IndexBuffer& ib = pool.GetIndexBuffer();
+    unsigned int firstIndex = ib.GetOffset() / ib.GetIndexSize();
+    unsigned int type = ib.GetType();
+
+    if (!g_GLCaps.DrawIndirect || !g_GLCaps.BaseInstance)
+    {
+        /*
+            Con GL 3.3 no hay comandos indirectos, y antes de GL 4.2 el baseInstance de un comando tiene que ser 0.
+            Se dibuja cada malla por separado y, en lugar de baseInstance, se corre el buffer por instancia del
+            pool para que la instancia 0 de esa malla lea su propio tramo.
+        */
+        pool.GetVertexArray().Validate(shader);
+        shader.Bind();
+        pool.GetVertexArray().Bind();
+        ib.Bind();
+
+        for (unsigned int i = 0; i < count; i++)
+        {
+            const MeshHandle& mesh = *draws[i].Mesh;
+            pool.SetFirstInstance(draws[i].BaseInstance);
+            const void* indices = (const void*)(uintptr_t)((firstIndex + mesh.FirstIndex) * ib.GetIndexSize());
+            GLCall(glDrawElementsInstancedBaseVertex(GL_TRIANGLES, mesh.IndexCount, type, indices, draws[i].InstanceCount, mesh.BaseVertex));
+        }
+        pool.SetFirstInstance(0);
+        return;
+    }
+
+    m_IndirectCommands.resize(count);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        const MeshHandle& mesh = *draws[i].Mesh;
+        m_IndirectCommands[i] = { mesh.IndexCount, draws[i].InstanceCount, firstIndex + mesh.FirstIndex, mesh.BaseVertex, draws[i].BaseInstance };
+    }
+
+    if (!m_IndirectBuffer)
+    {
+        GLCall(glGenBuffers(1, &m_IndirectBuffer));
+    }
+    GLStateCache::BindBuffer(GL_DRAW_INDIRECT_BUFFER, m_IndirectBuffer);
+
+    unsigned int size = count * (unsigned int)sizeof(DrawElementsIndirectCommand);
+    if (count > m_IndirectCapacity)
+    {
+        // Se reserva el doble para no volver a hacerlo cada vez que crece un poco la cantidad de comandos
+        m_IndirectCapacity = count * 2;
+        GLCall(glBufferData(GL_DRAW_INDIRECT_BUFFER, m_IndirectCapacity * sizeof(DrawElementsIndirectCommand), nullptr, GL_DYNAMIC_DRAW));
+    }
+    GLCall(glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, size, m_IndirectCommands.data()));
+
+    pool.GetVertexArray().Validate(shader);
+    shader.Bind();
+    pool.GetVertexArray().Bind();
+    ib.Bind();
+
+    // FirstIndex cuenta ndices, no bytes, as que los comandos valen igual para los dos tipos
+    if (g_GLCaps.MultiDrawIndirect)
+    {
+        GLCall(glMultiDrawElementsIndirect(GL_TRIANGLES, type, nullptr, count, 0));
+    }
+    else
+    {
+        // Con GL 4.2 pero sin 4.3 se recorre el mismo buffer de comandos con un glDrawElementsIndirect por malla
+        for (unsigned int i = 0; i < count; i++)
+        {
+            GLCall(glDrawElementsIndirect(GL_TRIANGLES, type, (const void*)(i * sizeof(DrawElementsIndirectCommand))));
+        }
+    }
+}
+
+/*
+    Distribucin de los 64 bits de la clave, del ms significativo al menos significativo:
+        - capa:         8 bits
+        - shader:      12 bits
+        - textura:     12 bits
+        - VAO:         12 bits
+        - profundidad: 20 bits
+    Los nombres de OpenGL pueden pasar de 4096, as que Submit no los usa directamente sino que les asigna
+    ndices densos por orden de aparicin en la cola (ver DenseKey). Recin con ms de 4096 objetos distintos
+    de un mismo tipo en un Flush se repetiran, y eso solo empeora el agrupamiento, no el orden por capa.
+*/
+uint64_t Renderer::MakeSortKey(unsigned char layer, unsigned int shader, unsigned int texture, unsigned int vao, float depth)
+{
+    const uint64_t idMask = (1ull << 12) - 1;
+    const uint64_t depthMax = (1ull << 20) - 1;
+
+    if (depth < 0.0f) depth = 0.0f;
+    if (depth > 1.0f) depth = 1.0f;
+
+    return ((uint64_t)layer << 56) |
+        ((shader & idMask) << 44) |
+        ((texture & idMask) << 32) |
+        ((vao & idMask) << 20) |
+        (uint64_t)(depth * depthMax);
+}
+
+void Renderer::RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch)
+{
+    // LSD radix sort de 8 bits por pasada. Es estable, as que a igual clave se respeta el orden de envo
+    scratch.resize(entries.size());
+
+    for (unsigned int shift = 0; shift < 64; shift += 8)
+    {
+        unsigned int histogram[256] = {};
+        for (const SortEntry& entry : entries)
+            histogram[(entry.Key >> shift) & 0xff]++;
+
+        // Si todas las claves tienen el mismo byte en esta posicin, la pasada no cambia nada
+        if (histogram[(entries[0].Key >> shift) & 0xff] == entries.size())
+            continue;
+
+        unsigned int offset = 0;
+        for (unsigned int i = 0; i < 256; i++)
+        {
+            unsigned int count = histogram[i];
+            histogram[i] = offset;
+            offset += count;
+        }
+
+        for (const SortEntry& entry : entries)
+            scratch[histogram[(entry.Key >> shift) & 0xff]++] = entry;
+
+        entries.swap(scratch);
+    }
+}
+
+// ndice denso de "id" dentro de la cola: el primero que aparece es 0, el siguiente distinto 1, y as
+static unsigned int DenseKey(std::unordered_map<unsigned int, unsigned int>& keys, unsigned int id)
+{
+    return keys.emplace(id, (unsigned int)keys.size()).first->second;
+}
+
+void Renderer::Submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+    const glm::mat4& model, unsigned char layer, float depth)
+{
+    unsigned int textureID = texture ? texture->GetRendererID() : 0;
+    uint64_t key = MakeSortKey(layer, DenseKey(m_ShaderKeys, shader.GetRendererID()), DenseKey(m_TextureKeys, textureID),
+        DenseKey(m_VertexArrayKeys, va.GetRendererID()), depth);
+
+    m_SortEntries.push_back({ key, (unsigned int)m_Commands.size() });
+    m_Commands.push_back({ &va, &ib, &shader, texture, model });
+}
+
+void Renderer::Flush()
+{
+    m_Stats = Stats();
+    if (m_Commands.empty())
+        return;
+
+    PROFILE_SCOPE("Renderer::Flush");
+    PROFILE_GPU_SCOPE("Renderer::Flush");
+
+    // Cambios de estado que habra costado ejecutar la cola tal como lleg
+    unsigned int unsortedChanges = 0;
+    {
+        const Shader* shader = nullptr;
+        const Texture* texture = nullptr;
+        const VertexArray* va = nullptr;
+        for (const RenderCommand& command : m_Commands)
+        {
+            unsortedChanges += command.Program != shader;
+            shader = command.Program;
+            if (command.Tex)
+            {
+                unsortedChanges += command.Tex != texture;
+                texture = command.Tex;
+            }
+            unsortedChanges += command.VA != va;
+            va = command.VA;
+        }
+    }
+
+    RadixSort(m_SortEntries, m_SortScratch);
+
+    /*
+        Cada objeto ocupa un tramo del UBO alineado a GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT. Los tramos de todo el Flush
+        se arman en orden en la CPU y se suben con una sola llamada, en la porcin siguiente del anillo.
+    */
+    unsigned int count = (unsigned int)m_Commands.size();
+    unsigned int alignment = UniformBuffer::GetOffsetAlignment();
+    unsigned int stride = ((unsigned int)sizeof(ObjectData) + alignment - 1) / alignment * alignment;
+    if (count > m_ObjectCapacity)
+    {
+        m_ObjectCapacity = 64;
+        while (m_ObjectCapacity < count)
+            m_ObjectCapacity *= 2;
+        m_ObjectBuffer = std::make_unique<UniformBuffer>(m_ObjectCapacity * stride * ObjectRingSize);
+    }
+
+    m_ObjectStaging.resize(count * stride);
+    for (unsigned int i = 0; i < count; i++)
+        std::memcpy(&m_ObjectStaging[i * stride], &m_Commands[m_SortEntries[i].Command].Model, sizeof(ObjectData));
+
+    unsigned int objectsOffset = m_ObjectRingIndex * m_ObjectCapacity * stride;
+    m_ObjectRingIndex = (m_ObjectRingIndex + 1) % ObjectRingSize;
+    m_ObjectBuffer->SetData(m_ObjectStaging.data(), count * stride, objectsOffset);
+    m_Stats.UniformUploads = 1;
+
+    const Shader* boundShader = nullptr;
+    const Texture* boundTexture = nullptr;
+    const VertexArray* boundVA = nullptr;
+    const IndexBuffer* boundIB = nullptr;
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        RenderCommand& command = m_Commands[m_SortEntries[i].Command];
+
+        bool pairChanged = false;
+        if (command.Program != boundShader)
+        {
+            command.Program->Bind();
+            boundShader = command.Program;
+            m_Stats.StateChanges++;
+            pairChanged = true;
+        }
+        if (command.Tex && command.Tex != boundTexture)
+        {
+            command.Tex->Bind();
+            boundTexture = command.Tex;
+            m_Stats.StateChanges++;
+        }
+        if (command.VA != boundVA)
+        {
+            command.VA->Bind();
+            boundVA = command.VA;
+            boundIB = nullptr;
+            m_Stats.StateChanges++;
+            pairChanged = true;
+        }
+        if (pairChanged)
+            command.VA->Validate(*command.Program);
+        if (command.IB != boundIB)
+        {
+            command.IB->Bind();
+            boundIB = command.IB;
+        }
+
+        m_ObjectBuffer->BindRange(UniformBuffer::ObjectBinding, objectsOffset + i * stride, sizeof(ObjectData));
+        GLCall(glDrawElements(GL_TRIANGLES, command.IB->GetCount(), command.IB->GetType(), command.IB->GetDrawOffset()));
+    }
+
+    m_Stats.Commands = (unsigned int)m_Commands.size();
+    // Con capas intercaladas el orden de envo podra ser mejor que el ordenado; en ese caso no hay ahorro
+    m_Stats.StateChangesSaved = unsortedChanges > m_Stats.StateChanges ? unsortedChanges - m_Stats.StateChanges : 0;
+
+    m_Commands.clear();
+    m_SortEntries.clear();
+    m_ShaderKeys.clear();
+    m_TextureKeys.clear();
+    m_VertexArrayKeys.clear();
+}
+
+BatchRenderer2D::BatchRenderer2D() :
+    m_VertexPtr(nullptr),
+    m_VertexCount(0),
+    m_VertexCapacity(0),
+    m_TextureSlotIndex(1)
+{
+    m_TextureSlots.fill(nullptr);
+
+    // Cada regin del buffer alcanza para varios lotes completos: los Flush de un mismo frame la comparten
+    m_VAO = std::make_unique<VertexArray>();
+    m_VertexBuffer = std::make_unique<StreamingVertexBuffer>(BatchesPerRegion * MaxVertices * (unsigned int)sizeof(QuadVertex));
+
+    using QuadLayout = VertexLayout<QuadVertex,
+        VERTEX_FIELD(QuadVertex, Position),
+        VERTEX_FIELD(QuadVertex, Color),
+        VERTEX_FIELD(QuadVertex, TexCoord),
+        VERTEX_FIELD(QuadVertex, TexIndex)>;
+    m_VAO->AddBuffer(*m_VertexBuffer, QuadLayout::Elements, QuadLayout::Stride);
+
+    /*
+        Todos los quads comparten el mismo patrn de ndices, as que el Index Buffer se arma una sola vez
+        para la capacidad mxima del lote y nunca se vuelve a tocar.
+    */
+    std::vector<unsigned int> indices(MaxIndices);
+    unsigned int offset = 0;
+    for (unsigned int i = 0; i < MaxIndices; i += 6)
+    {
+        indices[i + 0] = offset + 0;
+        indices[i + 1] = offset + 1;
+        indices[i + 2] = offset + 2;
+
+        indices[i + 3] = offset + 2;
+        indices[i + 4] = offset + 3;
+        indices[i + 5] = offset + 0;
+
+        offset += 4;
+    }
+    m_IndexBuffer = std::make_unique<IndexBuffer>(indices.data(), MaxIndices);
+
+    unsigned int white = 0xffffffff;
+    m_WhiteTexture = std::make_unique<Texture>(1, 1, &white);
+    m_TextureSlots[0] = m_WhiteTexture.get();
+
+    int samplers[MaxTextureSlots];
+    for (unsigned int i = 0; i < MaxTextureSlots; i++)
+        samplers[i] = i;
+
+    m_Shader = &ShaderLibrary::Get("res/shaders/Batch.shader");
+    m_Shader->Bind();
+    m_Shader->SetUniform1iv("u_Textures", MaxTextureSlots, samplers);
+}
+
+BatchRenderer2D::~BatchRenderer2D()
+{
+}
+
+void BatchRenderer2D::BeginBatch()
+{
+    StartBatch();
+}
+
+void BatchRenderer2D::Submit(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
+{
+    if (m_VertexCount + 4 > m_VertexCapacity)
+    {
+        Flush();
+        StartBatch();
+    }
+
+    PushQuad(position, size, color, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), 0.0f);
+}
+
+void BatchRenderer2D::Submit(const glm::vec2& position, const glm::vec2& size, const Texture& texture,
+    const glm::vec4& uvRect, const glm::vec4& tint)
+{
+    if (m_VertexCount + 4 > m_VertexCapacity)
+    {
+        Flush();
+        StartBatch();
+    }
+
+    float texIndex = GetTextureSlot(texture);
+    PushQuad(position, size, tint, uvRect, texIndex);
+}
+
+void BatchRenderer2D::EndBatch()
+{
+    Flush();
+    m_VertexBuffer->NextRegion();
+}
+
+void BatchRenderer2D::ResetStats()
+{
+    m_Stats = Stats();
+}
+
+void BatchRenderer2D::StartBatch()
+{
+    /*
+        Se mapea solo lo que queda de la regin actual (hasta un lote completo), as el lote siguiente sigue
+        a continuacin del anterior. Recin cuando no entra ni un quad se pide un lote entero, lo que pasa
+        a la regin siguiente.
+    */
+    const unsigned int quadSize = 4 * (unsigned int)sizeof(QuadVertex);
+    unsigned int size = std::min(m_VertexBuffer->GetAvailable(), MaxVertices * (unsigned int)sizeof(QuadVertex));
+    if (size < quadSize)
+        size = MaxVertices * (unsigned int)sizeof(QuadVertex);
+    size -= size % quadSize;
+
+    m_VertexPtr = (QuadVertex*)m_VertexBuffer->Map(size);
+    m_VertexCapacity = size / (unsigned int)sizeof(QuadVertex);
+    m_VertexCount = 0;
+    m_TextureSlotIndex = 1;
+}
+
+void BatchRenderer2D::Flush()
+{
+    if (m_VertexCount == 0)
+        return;
+
+    // El lote puede quedar en cualquier parte del buffer: los ndices se corren con baseVertex
+    unsigned int offset = m_VertexBuffer->Commit(m_VertexCount * (unsigned int)sizeof(QuadVertex));
+    int baseVertex = (int)(offset / sizeof(QuadVertex));
+
+    for (unsigned int i = 0; i < m_TextureSlotIndex; i++)
+        m_TextureSlots[i]->Bind(i);
+
+    m_VAO->Validate(*m_Shader);
+    m_Shader->Bind();
+    m_VAO->Bind();
+    m_IndexBuffer->Bind();
+
+    unsigned int quads = m_VertexCount / 4;
+    GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, quads * 6, m_IndexBuffer->GetType(), nullptr, baseVertex));
+
+    m_Stats.DrawCalls++;
+    m_Stats.QuadCount += quads;
+
+    // El lote siguiente arranca vaco y solo con la textura blanca en la ranura 0
+    m_VertexCount = 0;
+}
+
+void BatchRenderer2D::PushQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, const glm::vec4& uvRect, float texIndex)
+{
+    // Los vrtices se transforman ac, en la CPU, para que todo el lote se dibuje con una sola matriz
+    glm::vec2 min = position - size * 0.5f;
+    glm::vec2 max = position + size * 0.5f;
+
+    *m_VertexPtr++ = { { min.x, min.y, 0.0f }, color, { uvRect.x, uvRect.y }, texIndex };
+    *m_VertexPtr++ = { { max.x, min.y, 0.0f }, color, { uvRect.z, uvRect.y }, texIndex };
+    *m_VertexPtr++ = { { max.x, max.y, 0.0f }, color, { uvRect.z, uvRect.w }, texIndex };
+    *m_VertexPtr++ = { { min.x, max.y, 0.0f }, color, { uvRect.x, uvRect.w }, texIndex };
+    m_VertexCount += 4;
+}
+
+float BatchRenderer2D::GetTextureSlot(const Texture& texture)
+{
+    for (unsigned int i = 1; i < m_TextureSlotIndex; i++)
+    {
+        if (m_TextureSlots[i] == &texture)
+            return (float)i;
+    }
+
+    if (m_TextureSlotIndex == MaxTextureSlots)
+    {
+        Flush();
+        StartBatch();
+    }
+
+    m_TextureSlots[m_TextureSlotIndex] = &texture;
+    return (float)m_TextureSlotIndex++;
 }
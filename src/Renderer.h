@@ -1,22 +1,137 @@
 #pragma once
 
-#include <GL/glew.h>
+#include "GLDispatch.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "VertexArray.h"
 #include "IndexBuffer.h"
 #include "Shader.h"
 
-#define ASSERT(x) if (!(x)) __debugbreak();
-#define GLCall(x) GLClearError();\
-    x;\
-    ASSERT(GLLogCall(#x, __FILE__, __LINE__))
+#include "glm/glm.hpp"
+
+class Texture;
+class StreamingVertexBuffer;
+class MeshPool;
+class UniformBuffer;
+struct MeshHandle;
+
+#if defined(_MSC_VER)
+    #define DEBUG_BREAK() __debugbreak()
+#else
+    #include <csignal>
+    #define DEBUG_BREAK() std::raise(SIGTRAP)
+#endif
+
+#define ASSERT(x) if (!(x)) DEBUG_BREAK();
+
+/*
+    Niveles de chequeo de errores de OpenGL:
+        - OFF: no se consulta nunca glGetError.
+        - PER_FRAME: una sola consulta al final de cada frame (GLCheckFrameErrors). No dice qu llamada fall.
+        - PER_CALL: cada GLCall limpia y consulta glGetError. Da la llamada exacta, pero cada glGetError
+                    obliga al driver a sincronizarse, as que es lento.
+        - DEBUG_OUTPUT: OpenGL avisa los errores por callback (GL_KHR_debug), con filtro por origen y severidad.
+
+    GL_ERROR_CHECK define el nivel mximo que se compila. Con OFF, GLCall(x) queda en solo x y no hay
+    ningn costo. En tiempo de ejecucin se puede elegir cualquier nivel que no supere al compilado.
+*/
+#define GL_ERROR_CHECK_OFF          0
+#define GL_ERROR_CHECK_PER_FRAME    1
+#define GL_ERROR_CHECK_PER_CALL     2
+#define GL_ERROR_CHECK_DEBUG_OUTPUT 3
+
+#ifndef GL_ERROR_CHECK
+    #ifdef _DEBUG
+        #define GL_ERROR_CHECK GL_ERROR_CHECK_DEBUG_OUTPUT
+    #else
+        #define GL_ERROR_CHECK GL_ERROR_CHECK_OFF
+    #endif
+#endif
+
+#if GL_ERROR_CHECK >= GL_ERROR_CHECK_PER_CALL
+    #define GLCall(x) GLClearError();\
+        x;\
+        ASSERT(GLLogCall(#x, __FILE__, __LINE__))
+#else
+    #define GLCall(x) x
+#endif
+
+enum class GLErrorCheckLevel
+{
+    Off = GL_ERROR_CHECK_OFF,
+    PerFrame = GL_ERROR_CHECK_PER_FRAME,
+    PerCall = GL_ERROR_CHECK_PER_CALL,
+    DebugOutput = GL_ERROR_CHECK_DEBUG_OUTPUT
+};
 
 void GLClearError();
 
 bool GLLogCall(const char* function, const char* file, int line);
 
+/// <summary>
+/// Cambia el nivel de chequeo en tiempo de ejecucin. Si se pide un nivel mayor al compilado se usa el compilado,
+/// y si se pide DebugOutput pero el contexto no soporta GL_KHR_debug se usa PerCall.
+/// </summary>
+void GLSetErrorCheckLevel(GLErrorCheckLevel level);
+GLErrorCheckLevel GLGetErrorCheckLevel();
+
+/// <summary>
+/// Filtra los mensajes del callback de depuracin
+/// </summary>
+/// <param name="source">Origen de los mensajes a mostrar (GL_DEBUG_SOURCE_*), o GL_DONT_CARE para todos</param>
+/// <param name="minSeverity">Severidad mnima a mostrar (GL_DEBUG_SEVERITY_*). Con otro valor se muestran todas</param>
+void GLSetDebugMessageFilter(unsigned int source, unsigned int minSeverity);
+
+// Consulta los errores acumulados en el frame. Hay que llamarla una vez, al final de cada frame
+void GLCheckFrameErrors();
+
 class Renderer
 {
 public:
+    struct Stats
+    {
+        unsigned int Commands = 0;
+        // Cambios de programa, textura y VAO que se hicieron al ejecutar la cola ordenada
+        unsigned int StateChanges = 0;
+        // Cambios que se habran hecho ejecutando los comandos en el orden en que se enviaron, menos los anteriores
+        unsigned int StateChangesSaved = 0;
+        // Subidas al buffer de datos por objeto. Es una por Flush, sin importar cuntos comandos haya
+        unsigned int UniformUploads = 0;
+    };
+
+    // Lo que ve el bloque "Camera" (std140) de los shaders
+    struct CameraData
+    {
+        glm::mat4 ViewProjection;
+        glm::mat4 View;
+        glm::mat4 Projection;
+    };
+
+    // Una malla del pool con sus instancias, para DrawIndirect
+    struct IndirectDraw
+    {
+        const MeshHandle* Mesh;
+        unsigned int InstanceCount;
+        // Primera instancia a leer de los buffers con divisor. Permite que cada malla use su propio tramo
+        unsigned int BaseInstance;
+    };
+
+    Renderer();
+    ~Renderer();
+
+    /// <summary>
+    /// Sube la cmara del frame al UBO compartido del bloque "Camera" y lo enlaza. Se llama una vez por frame
+    /// antes de dibujar: todos los programas leen la vista y la proyeccin de ah, sin uniforms propios.
+    /// </summary>
+    static void BeginScene(const glm::mat4& view, const glm::mat4& projection);
+
+    // Libera el UBO de la cmara. Se llama antes de destruir el contexto
+    static void Shutdown();
+
     /*
         Para poder dibujar necesitamos:
             - un Vertex Array (este tiene asociado un Vertex Buffer asociado)
@@ -25,4 +140,187 @@ public:
     */
     void Clear();
     void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+
+    /// <summary>
+    /// Dibuja "instanceCount" copias de la misma malla con una sola llamada. Lo que cambia entre copias
+    /// tiene que venir de atributos con divisor (ver VertexBufferLayout::Push) en un buffer por instancia.
+    /// </summary>
+    void DrawInstanced(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int instanceCount) const;
+
+    /// <summary>
+    /// Dibuja varias mallas distintas de un mismo MeshPool con una sola llamada a glMultiDrawElementsIndirect.
+    /// Los comandos se arman en la CPU y se suben a un buffer de comandos que el Renderer reutiliza.
+    /// Sin draw indirect o sin baseInstance hace una llamada por malla; si alguna usa BaseInstance, el pool
+    /// tiene que tener su buffer por instancia asociado con MeshPool::SetInstanceBuffer.
+    /// </summary>
+    void DrawIndirect(const MeshPool& pool, const Shader& shader, const IndirectDraw* draws, unsigned int count);
+
+    /// <summary>
+    /// Encola un comando de dibujo en lugar de ejecutarlo. Los comandos se ordenan por su clave
+    /// (capa, shader, textura, VAO, profundidad) y se ejecutan todos juntos en Flush, de modo que los
+    /// que comparten estado quedan contiguos y no hace falta volver a enlazarlo entre ellos.
+    /// </summary>
+    /// <param name="texture">Textura a enlazar en la ranura 0, o nullptr si el shader no usa ninguna</param>
+    /// <param name="model">Matriz del objeto. Le llega al shader por el bloque "Object"</param>
+    /// <param name="layer">Capa de dibujo. Las capas menores se dibujan antes, sin importar el estado</param>
+    /// <param name="depth">Profundidad normalizada entre 0 y 1, usada como ltimo criterio de orden</param>
+    void Submit(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, const Texture* texture,
+        const glm::mat4& model, unsigned char layer = 0, float depth = 0.0f);
+
+    /// <summary>
+    /// Ordena la cola del frame y la ejecuta. Los datos por objeto de todos los comandos se suben juntos
+    /// a una porcin del UBO de objetos, y cada draw solo enlaza su tramo con glBindBufferRange.
+    /// </summary>
+    void Flush();
+
+    inline const Stats& GetStats() const { return m_Stats; }
+
+private:
+    struct RenderCommand
+    {
+        const VertexArray* VA;
+        const IndexBuffer* IB;
+        const Shader* Program;
+        const Texture* Tex;
+        glm::mat4 Model;
+    };
+
+    // Lo que ve el bloque "Object" (std140) de los shaders
+    struct ObjectData
+    {
+        glm::mat4 Model;
+    };
+
+    // Porciones del UBO de objetos que se usan por turnos, para no pisar datos que la GPU puede estar leyendo
+    static const unsigned int ObjectRingSize = 3;
+
+    // Formato que espera OpenGL en GL_DRAW_INDIRECT_BUFFER
+    struct DrawElementsIndirectCommand
+    {
+        unsigned int Count;
+        unsigned int InstanceCount;
+        unsigned int FirstIndex;
+        int BaseVertex;
+        unsigned int BaseInstance;
+    };
+
+    struct SortEntry
+    {
+        uint64_t Key;
+        unsigned int Command;
+    };
+
+    static uint64_t MakeSortKey(unsigned char layer, unsigned int shader, unsigned int texture, unsigned int vao, float depth);
+    static void RadixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+
+    std::vector<RenderCommand> m_Commands;
+    std::vector<SortEntry> m_SortEntries;
+    std::vector<SortEntry> m_SortScratch;
+
+    // Nombre de OpenGL -> ndice denso dentro de la cola actual, para que quepan en los campos de MakeSortKey
+    std::unordered_map<unsigned int, unsigned int> m_ShaderKeys;
+    std::unordered_map<unsigned int, unsigned int> m_TextureKeys;
+    std::unordered_map<unsigned int, unsigned int> m_VertexArrayKeys;
+
+    std::vector<DrawElementsIndirectCommand> m_IndirectCommands;
+    unsigned int m_IndirectBuffer;
+    // Comandos que entran en m_IndirectBuffer sin tener que volver a reservarlo
+    unsigned int m_IndirectCapacity;
+
+    std::unique_ptr<UniformBuffer> m_ObjectBuffer;
+    std::vector<unsigned char> m_ObjectStaging;
+    // Objetos que entran en cada porcin del anillo
+    unsigned int m_ObjectCapacity;
+    unsigned int m_ObjectRingIndex;
+
+    Stats m_Stats;
+};
+
+/// <summary>
+/// Renderer de quads por lotes. En lugar de hacer un Draw por cada cuadrado, los quads enviados entre
+/// BeginBatch y EndBatch se transforman en la CPU y se acumulan en un nico Vertex Buffer dinmico, que
+/// se dibuja con una sola llamada usando un Index Buffer compartido que se construye una nica vez.
+/// El lote se vaca solo cuando se llena el buffer de vrtices o se acaban las ranuras de textura.
+/// </summary>
+class BatchRenderer2D
+{
+public:
+    static const unsigned int MaxQuads = 10000;
+    static const unsigned int MaxVertices = MaxQuads * 4;
+    static const unsigned int MaxIndices = MaxQuads * 6;
+    // Lotes completos que entran en cada regin del buffer de vrtices. Un frame con ms lotes que estos pasa
+    // a la regin siguiente, que puede estar todava en uso por la GPU
+    static const unsigned int BatchesPerRegion = 4;
+    // 16 es la cantidad mnima de unidades de textura que garantiza OpenGL en el fragment shader
+    static const unsigned int MaxTextureSlots = 16;
+
+    struct Stats
+    {
+        unsigned int DrawCalls = 0;
+        unsigned int QuadCount = 0;
+    };
+
+    BatchRenderer2D();
+    ~BatchRenderer2D();
+
+    // La cmara sale del bloque "Camera", as que antes hay que llamar a Renderer::BeginScene
+    void BeginBatch();
+
+    /// <summary>
+    /// Agrega un quad de color plano al lote
+    /// </summary>
+    /// <param name="position">Centro del quad</param>
+    /// <param name="size">Ancho y alto del quad</param>
+    /// <param name="color">Color RGBA</param>
+    void Submit(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+
+    /// <summary>
+    /// Agrega un quad texturizado al lote
+    /// </summary>
+    /// <param name="position">Centro del quad</param>
+    /// <param name="size">Ancho y alto del quad</param>
+    /// <param name="texture">Textura a usar. Se le asigna una ranura libre del lote; si no quedan, se dibuja el lote actual</param>
+    /// <param name="uvRect">Rectngulo de la textura a muestrear: (u0, v0, u1, v1)</param>
+    /// <param name="tint">Color por el que se multiplica la textura</param>
+    void Submit(const glm::vec2& position, const glm::vec2& size, const Texture& texture,
+        const glm::vec4& uvRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), const glm::vec4& tint = glm::vec4(1.0f));
+
+    void EndBatch();
+
+    inline const Stats& GetStats() const { return m_Stats; }
+    void ResetStats();
+
+private:
+    struct QuadVertex
+    {
+        glm::vec3 Position;
+        glm::vec4 Color;
+        glm::vec2 TexCoord;
+        float TexIndex;
+    };
+
+    void StartBatch();
+    void Flush();
+    void PushQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color, const glm::vec4& uvRect, float texIndex);
+    float GetTextureSlot(const Texture& texture);
+
+    std::unique_ptr<VertexArray> m_VAO;
+    std::unique_ptr<StreamingVertexBuffer> m_VertexBuffer;
+    std::unique_ptr<IndexBuffer> m_IndexBuffer;
+    // Lo administra ShaderLibrary
+    Shader* m_Shader;
+
+    // Textura blanca de 1x1 en la ranura 0, para que los quads de color plano no necesiten otro shader
+    std::unique_ptr<Texture> m_WhiteTexture;
+
+    // Los vrtices del lote se escriben directamente en la regin del buffer que devuelve StreamingVertexBuffer::Map
+    QuadVertex* m_VertexPtr;
+    unsigned int m_VertexCount;
+    // Vrtices que entran en lo mapeado por StartBatch; puede ser menos que MaxVertices al final de una regin
+    unsigned int m_VertexCapacity;
+
+    std::array<const Texture*, MaxTextureSlots> m_TextureSlots;
+    unsigned int m_TextureSlotIndex;
+
+    Stats m_Stats;
 };
\ No newline at end of file
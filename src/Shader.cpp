@@ -1,61 +1,530 @@
 #include "Shader.h"
 
 #include <iostream>
-#include <fstream>
 #include <string>
-#include <sstream>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define SHADER_USE_SSE2
+#endif
 
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "Profiler.h"
+#include "ShaderCache.h"
+#include "ShaderBundle.h"
+#include "UniformBuffer.h"
+
+static Shader::UniformStats s_UniformStats;
 
-Shader::Shader(const std::string& filepath)
+// Todos los Shader vivos, para poder recargarlos por nombre de archivo
+static std::vector<Shader*> s_Shaders;
+
+/*
+    Suben un valor a "program". Con DSA van directo al programa con glProgramUniform, sin tocar el que est en
+    uso; sin DSA, glUniform escribe en el programa en uso, as que quien llama tiene que haberlo enlazado antes.
+*/
+static void UploadUniform1iv(unsigned int program, int location, int count, const int* values)
 {
-    ShaderProgramSource shaders = ParseShader(filepath);
+    if (g_GLCaps.DirectStateAccess)
+    {
+        GLCall(glProgramUniform1iv(program, location, count, values));
+    }
+    else
+    {
+        GLCall(glUniform1iv(location, count, values));
+    }
+}
 
-    m_RendererID = CreateShader(shaders.VertexSource, shaders.FragmentSource);
+static void UploadUniform4f(unsigned int program, int location, float v0, float v1, float v2, float v3)
+{
+    if (g_GLCaps.DirectStateAccess)
+    {
+        GLCall(glProgramUniform4f(program, location, v0, v1, v2, v3));
+    }
+    else
+    {
+        GLCall(glUniform4f(location, v0, v1, v2, v3));
+    }
+}
+
+static void UploadUniformMat4f(unsigned int program, int location, const float* matrix)
+{
+    if (g_GLCaps.DirectStateAccess)
+    {
+        GLCall(glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, matrix));
+    }
+    else
+    {
+        GLCall(glUniformMatrix4fv(location, 1, GL_FALSE, matrix));
+    }
+}
+
+// Compara los 64 bytes de dos mat4 bit a bit, de a 16 bytes por instruccin
+static bool Mat4Equal(const float* a, const float* b)
+{
+#ifdef SHADER_USE_SSE2
+    __m128i equal = _mm_set1_epi32(-1);
+    for (int i = 0; i < 16; i += 4)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        equal = _mm_and_si128(equal, _mm_cmpeq_epi32(va, vb));
+    }
+    return _mm_movemask_epi8(equal) == 0xffff;
+#else
+    return std::memcmp(a, b, 16 * sizeof(float)) == 0;
+#endif
+}
+
+Shader::Shader(const std::string& filepath, const std::vector<std::string>& defines)
+    : m_FilePath(filepath)
+{
+    PreprocessedShader shader = ShaderBundle::Load(filepath, defines);
+    SetSource(shader);
+    const ShaderProgramSource& shaders = shader.Source;
+
+    // Si el mismo cdigo ya se enlaz con este driver, se carga el binario y no se compila nada
+    double start = Profiler::Now();
+    uint64_t key = ShaderCache::MakeKey(shaders);
+    m_RendererID = ShaderCache::Load(key);
+
+    bool hit = m_RendererID != 0;
+    if (!hit)
+    {
+        m_RendererID = CreateShader(shaders.VertexSource, shaders.FragmentSource);
+        if (m_RendererID)
+            ShaderCache::Store(key, m_RendererID);
+    }
+
+    ResolveUniforms();
+
+    // Se ve en el panel de estadsticas junto con el resto de las cargas
+    ShaderCache::RecordLoad(hit, (Profiler::Now() - start) / 1000.0);
+
+    s_Shaders.push_back(this);
+}
+
+Shader::Shader(const PreprocessedShader& shader, unsigned int program)
+    : m_FilePath(shader.FilePath), m_RendererID(program)
+{
+    SetSource(shader);
+    ResolveUniforms();
+    s_Shaders.push_back(this);
 }
 
 Shader::~Shader()
 {
+    s_Shaders.erase(std::find(s_Shaders.begin(), s_Shaders.end(), this));
+
+    if (m_Reload.Program)
+    {
+        unsigned int program = FinishProgram(m_Reload);
+        GLCall(glDeleteProgram(program));
+    }
+
+    GLCall(glDeleteProgram(m_RendererID));
+    GLStateCache::OnProgramDeleted(m_RendererID);
+}
+
+void Shader::Reload()
+{
+    // Si ya haba una recarga en curso, se descarta: el archivo cambi otra vez
+    if (m_Reload.Program)
+    {
+        unsigned int program = FinishProgram(m_Reload);
+        GLCall(glDeleteProgram(program));
+    }
+
+    // Se lee siempre el archivo, nunca el paquete: lo que cambi es el cdigo fuente
+    // Las claves y archivos actuales siguen describiendo al programa en uso hasta que el nuevo enlace
+    m_ReloadSource = ShaderPreprocessor::Process(m_FilePath, m_Defines);
+    m_Reload = BeginProgram(m_ReloadSource.Source);
+    m_Reload.CacheKey = ShaderCache::MakeKey(m_ReloadSource.Source);
+}
+
+void Shader::SetSource(const PreprocessedShader& shader)
+{
+    m_Defines = shader.Defines;
+    m_Features = shader.Features;
+    m_Files = shader.Files;
+}
+
+Shader& Shader::GetVariant(std::initializer_list<const char*> features)
+{
+    uint32_t mask = 0;
+    for (const char* feature : features)
+    {
+        auto found = std::find(m_Features.begin(), m_Features.end(), feature);
+        if (found == m_Features.end())
+        {
+            std::cout << "Warning: shader '" << m_FilePath << "' doesn't declare feature '" << feature << "'!" << std::endl;
+            continue;
+        }
+        mask |= 1u << (found - m_Features.begin());
+    }
+
+    if (mask == 0)
+        return *this;
+
+    for (const auto& variant : m_Variants)
+    {
+        if (variant.first == mask)
+            return *variant.second;
+    }
+
+    std::vector<std::string> defines = m_Defines;
+    for (unsigned int i = 0; i < m_Features.size(); i++)
+    {
+        if (mask & (1u << i))
+            defines.push_back(m_Features[i]);
+    }
+
+    m_Variants.emplace_back(mask, std::make_unique<Shader>(m_FilePath, defines));
+    return *m_Variants.back().second;
+}
+
+void Shader::ReloadFile(const std::string& filepath)
+{
+    std::string path = std::filesystem::path(filepath).lexically_normal().generic_string();
+    for (Shader* shader : s_Shaders)
+    {
+        const std::vector<std::string>& staged = shader->m_ReloadSource.Files;
+        if (std::find(shader->m_Files.begin(), shader->m_Files.end(), path) != shader->m_Files.end() ||
+            std::find(staged.begin(), staged.end(), path) != staged.end())
+            shader->Reload();
+    }
+}
+
+void Shader::UpdateReloads()
+{
+    for (Shader* shader : s_Shaders)
+    {
+        if (!shader->m_Reload.Program || !IsProgramReady(shader->m_Reload))
+            continue;
+
+        uint64_t key = shader->m_Reload.CacheKey;
+        unsigned int program = FinishProgram(shader->m_Reload);
+        shader->m_Reload = PendingProgram();
+        if (!program)
+        {
+            std::cout << "Shader '" << shader->m_FilePath << "': reload failed, keeping the previous program" << std::endl;
+            continue;
+        }
+
+        ShaderCache::Store(key, program);
+        shader->SwapProgram(program, shader->m_ReloadSource);
+        shader->m_ReloadSource = PreprocessedShader();
+        std::cout << "Shader '" << shader->m_FilePath << "': reloaded" << std::endl;
+    }
+}
+
+void Shader::SwapProgram(unsigned int program, const PreprocessedShader& source)
+{
+    SetSource(source);
+
+    // Los valores subidos al programa viejo se pierden con l, pero la copia en la CPU sigue estando
+    std::vector<unsigned char> sizes = m_UniformValueSizes;
+
     GLCall(glDeleteProgram(m_RendererID));
+    GLStateCache::OnProgramDeleted(m_RendererID);
+    m_RendererID = program;
+    ResolveUniforms();
+
+    if (!g_GLCaps.DirectStateAccess)
+        GLStateCache::UseProgram(m_RendererID);
+    for (size_t i = 0; i < sizes.size(); i++)
+    {
+        int location = m_UniformLocations[i];
+        const UniformValue& value = m_UniformValues[i];
+        if (!sizes[i] || location == -1)
+            continue;
+
+        switch (m_UniformTypes[i])
+        {
+            case GL_FLOAT_MAT4:
+                UploadUniformMat4f(m_RendererID, location, value.Data);
+                break;
+            case GL_FLOAT_VEC4:
+                UploadUniform4f(m_RendererID, location, value.Data[0], value.Data[1], value.Data[2], value.Data[3]);
+                break;
+            case GL_INT:
+            case GL_SAMPLER_2D:
+                UploadUniform1iv(m_RendererID, location, sizes[i] / sizeof(int), (const int*)value.Data);
+                break;
+            default:
+                // Tipo que SetUniform no sube o uniform que ya no existe: queda con el valor por defecto
+                continue;
+        }
+        m_UniformValueSizes[i] = sizes[i];
+    }
 }
 
 void Shader::Bind() const
 {
-    GLCall(glUseProgram(m_RendererID));
+    GLStateCache::UseProgram(m_RendererID);
 }
 
 void Shader::Unbind() const
 {
-    GLCall(glUseProgram(0));
+    GLStateCache::UseProgram(0);
+}
+
+void Shader::SetUniform1i(UniformHandle uniform, int value)
+{
+    if (ShouldUpload(uniform, &value, sizeof(value)))
+    {
+        if (g_GLCaps.DirectStateAccess)
+        {
+            GLCall(glProgramUniform1i(m_RendererID, GetLocation(uniform), value));
+        }
+        else
+        {
+            GLCall(glUniform1i(GetLocation(uniform), value));
+        }
+    }
 }
 
-void Shader::SetUniform1i(const std::string& name, int value)
+void Shader::SetUniform1iv(UniformHandle uniform, int count, const int* values)
 {
-    GLCall(glUniform1i(GetUniformLocation(name), value));
+    if (ShouldUpload(uniform, values, count * sizeof(int)))
+        UploadUniform1iv(m_RendererID, GetLocation(uniform), count, values);
 }
 
-void Shader::SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3)
+void Shader::SetUniform4f(UniformHandle uniform, float v0, float v1, float v2, float v3)
 {
-    GLCall(glUniform4f(GetUniformLocation(name), v0, v1, v2, v3));
+    float values[4] = { v0, v1, v2, v3 };
+    if (ShouldUpload(uniform, values, sizeof(values)))
+        UploadUniform4f(m_RendererID, GetLocation(uniform), v0, v1, v2, v3);
 }
 
-void Shader::SetUniformMat4f(const std::string& name, const glm::mat4& matrix)
+void Shader::SetUniformMat4f(UniformHandle uniform, const glm::mat4& matrix)
 {
     // La v de la funcin indica que le estamos pasando un vector de floats
-    glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &matrix[0][0]);
+    if (ShouldUpload(uniform, &matrix[0][0], sizeof(matrix)))
+        UploadUniformMat4f(m_RendererID, GetLocation(uniform), &matrix[0][0]);
+}
+
+void Shader::SetUniform1i(const char* name, int value)
+{
+    SetUniform1i(GetUniform(name), value);
+}
+
+void Shader::SetUniform1iv(const char* name, int count, const int* values)
+{
+    SetUniform1iv(GetUniform(name), count, values);
+}
+
+void Shader::SetUniform4f(const char* name, float v0, float v1, float v2, float v3)
+{
+    SetUniform4f(GetUniform(name), v0, v1, v2, v3);
+}
+
+void Shader::SetUniformMat4f(const char* name, const glm::mat4& matrix)
+{
+    SetUniformMat4f(GetUniform(name), matrix);
 }
 
-int Shader::GetUniformLocation(const std::string& name) const
+const Shader::UniformStats& Shader::GetUniformStats()
 {
-    if (m_UniformLocationCache.find(name) != m_UniformLocationCache.end())
-        return m_UniformLocationCache[name];
+    return s_UniformStats;
+}
 
-    GLCall(int location = glGetUniformLocation(m_RendererID, name.c_str()));
+void Shader::ResetUniformStats()
+{
+    s_UniformStats = UniformStats();
+}
+
+bool Shader::ShouldUpload(UniformHandle uniform, const void* value, unsigned int size)
+{
+    // Un uniform que no existe en el programa no tiene nada que subir
+    if (GetLocation(uniform) == -1)
+    {
+        s_UniformStats.Skipped++;
+        return false;
+    }
+
+    // Los arreglos grandes no entran en la copia; esos se suben siempre
+    if (size > sizeof(UniformValue))
+    {
+        s_UniformStats.Issued++;
+        return true;
+    }
+
+    UniformValue& shadow = m_UniformValues[uniform.Index];
+    unsigned char& shadowSize = m_UniformValueSizes[uniform.Index];
+    if (shadowSize == size)
+    {
+        bool equal = size == sizeof(UniformValue) ? Mat4Equal(shadow.Data, (const float*)value) : std::memcmp(shadow.Data, value, size) == 0;
+        if (equal)
+        {
+            s_UniformStats.Skipped++;
+            return false;
+        }
+    }
+
+    std::memcpy(shadow.Data, value, size);
+    shadowSize = (unsigned char)size;
+    s_UniformStats.Issued++;
+    return true;
+}
+
+UniformHandle Shader::AddUniform(const std::string& name, int location)
+{
+    m_UniformNames.push_back(name);
+    m_UniformLocations.push_back(location);
+    m_UniformTypes.push_back(0);
+    m_UniformValues.push_back(UniformValue());
+    m_UniformValueSizes.push_back(0);
+    return { (int)m_UniformNames.size() - 1 };
+}
+
+UniformHandle Shader::GetUniform(const char* name)
+{
+    for (size_t i = 0; i < m_UniformNames.size(); i++)
+    {
+        if (m_UniformNames[i] == name)
+            return { (int)i };
+    }
+
+    // No estaba entre los uniforms activos: se registra igual, para que el handle sirva si un nuevo enlace lo agrega
+    GLCall(int location = glGetUniformLocation(m_RendererID, name));
     if (location == -1)
         std::cout << "Warning: uniform '" << name << "' doesn't exist!" << std::endl;
 
-    m_UniformLocationCache[name] = location;
-    return location;
+    return AddUniform(name, location);
+}
+
+bool Shader::BindUniformBlock(const char* blockName, unsigned int binding)
+{
+    GLCall(unsigned int index = glGetUniformBlockIndex(m_RendererID, blockName));
+    if (index == GL_INVALID_INDEX)
+        return false;
+
+    GLCall(glUniformBlockBinding(m_RendererID, index, binding));
+    return true;
+}
+
+// Orden de la tabla de reflexin: primero por tipo de recurso y despus por nombre
+static bool ResourceLess(const ShaderResource& resource, const std::pair<ShaderResourceKind, const std::string*>& key)
+{
+    if (resource.Kind != key.first)
+        return resource.Kind < key.first;
+    return resource.Name < *key.second;
+}
+
+const ShaderResource* Shader::FindResource(ShaderResourceKind kind, const std::string& name) const
+{
+    auto key = std::make_pair(kind, &name);
+    auto found = std::lower_bound(m_Resources.begin(), m_Resources.end(), key, ResourceLess);
+    if (found == m_Resources.end() || found->Kind != kind || found->Name != name)
+        return nullptr;
+
+    return &*found;
+}
+
+void Shader::Reflect()
+{
+    m_Resources.clear();
+
+    int count = 0, maxLength = 0;
+    std::string name;
+
+    GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_ATTRIBUTES, &count));
+    GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength));
+    for (int i = 0; i < count; i++)
+    {
+        name.resize(maxLength);
+        int length = 0, size = 0;
+        unsigned int type = 0;
+        GLCall(glGetActiveAttrib(m_RendererID, i, maxLength, &length, &size, &type, &name[0]));
+        name.resize(length);
+
+        // Las entradas propias de GLSL (gl_VertexID, gl_InstanceID) no salen de ningn buffer
+        if (name.compare(0, 3, "gl_") == 0)
+            continue;
+
+        GLCall(int location = glGetAttribLocation(m_RendererID, name.c_str()));
+        m_Resources.push_back({ ShaderResourceKind::Attribute, name, location, type, size });
+    }
+
+    GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORMS, &count));
+    GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength));
+    for (int i = 0; i < count; i++)
+    {
+        name.resize(maxLength);
+        int length = 0, size = 0;
+        unsigned int type = 0;
+        GLCall(glGetActiveUniform(m_RendererID, i, maxLength, &length, &size, &type, &name[0]));
+        name.resize(length);
+
+        // Los arreglos se listan como "u_Textures[0]", pero se usan por el nombre sin ndice
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+            name.resize(name.size() - 3);
+
+        GLCall(int location = glGetUniformLocation(m_RendererID, name.c_str()));
+        m_Resources.push_back({ ShaderResourceKind::Uniform, name, location, type, size });
+    }
+
+    GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_BLOCKS, &count));
+    GLCall(glGetProgramiv(m_RendererID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength));
+    for (int i = 0; i < count; i++)
+    {
+        name.resize(maxLength);
+        int length = 0, binding = 0, size = 0;
+        GLCall(glGetActiveUniformBlockName(m_RendererID, i, maxLength, &length, &name[0]));
+        name.resize(length);
+        GLCall(glGetActiveUniformBlockiv(m_RendererID, i, GL_UNIFORM_BLOCK_BINDING, &binding));
+        GLCall(glGetActiveUniformBlockiv(m_RendererID, i, GL_UNIFORM_BLOCK_DATA_SIZE, &size));
+        m_Resources.push_back({ ShaderResourceKind::UniformBlock, name, binding, 0, size });
+    }
+
+    std::sort(m_Resources.begin(), m_Resources.end(), [](const ShaderResource& a, const ShaderResource& b)
+    {
+        return ResourceLess(a, std::make_pair(b.Kind, &b.Name));
+    });
+}
+
+void Shader::ResolveUniforms()
+{
+    // El enlace de los bloques es estado del programa, as que hay que repetirlo despus de cada enlace o carga de binario
+    BindUniformBlock("Camera", UniformBuffer::CameraBinding);
+    BindUniformBlock("Object", UniformBuffer::ObjectBinding);
+
+    Reflect();
+
+    // Las ubicaciones de los nombres ya registrados pueden cambiar de un enlace a otro, y los valores vuelven a cero
+    for (size_t i = 0; i < m_UniformNames.size(); i++)
+    {
+        const ShaderResource* uniform = FindResource(ShaderResourceKind::Uniform, m_UniformNames[i]);
+        if (uniform)
+        {
+            m_UniformLocations[i] = uniform->Location;
+            m_UniformTypes[i] = uniform->Type;
+        }
+        else
+        {
+            // Puede ser un elemento de un arreglo ("u_Textures[3]"), que no tiene su propia entrada
+            GLCall(m_UniformLocations[i] = glGetUniformLocation(m_RendererID, m_UniformNames[i].c_str()));
+            m_UniformTypes[i] = 0;
+        }
+        m_UniformValueSizes[i] = 0;
+    }
+
+    // Los uniforms sueltos que nadie pidi todava se registran ya resueltos, as GetUniform no tiene que ir al driver
+    for (const ShaderResource& uniform : m_Resources)
+    {
+        if (uniform.Kind != ShaderResourceKind::Uniform || uniform.Location == -1)
+            continue;
+        if (std::find(m_UniformNames.begin(), m_UniformNames.end(), uniform.Name) != m_UniformNames.end())
+            continue;
+
+        UniformHandle handle = AddUniform(uniform.Name, uniform.Location);
+        m_UniformTypes[handle.Index] = uniform.Type;
+    }
 }
 
 unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
@@ -72,69 +541,107 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string& source)
     GLCall(glShaderSource(id, 1, &src, nullptr));
     GLCall(glCompileShader(id));
 
-    // Error handling
+    return id;
+}
+
+// Muestra el log de compilacin si el shader no compil
+static bool CheckCompileStatus(unsigned int id, unsigned int type)
+{
     int result;
     GLCall(glGetShaderiv(id, GL_COMPILE_STATUS, &result));
     if (result == GL_FALSE)
     {
         int length;
         GLCall(glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length));
-        char* message = (char*)alloca(length * sizeof(char));
+        char* message = (char*)alloca((length + 1) * sizeof(char));
+        message[0] = '\0';
         GLCall(glGetShaderInfoLog(id, length, &length, message));
         std::cout << "Failed to compile " <<
             (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader!" <<
             std::endl;
         std::cout << message << std::endl;
-        GLCall(glDeleteShader(id));
-        return 0;
+        return false;
     }
 
-    return id;
+    return true;
 }
 
-unsigned int Shader::CreateShader(const std::string& vertexShader, const std::string& fragmentShader)
+Shader::PendingProgram Shader::BeginProgram(const ShaderProgramSource& source)
 {
-    GLCall(unsigned int program = glCreateProgram());
-    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+    PendingProgram pending;
+    GLCall(pending.Program = glCreateProgram());
+    pending.VertexShader = CompileShader(GL_VERTEX_SHADER, source.VertexSource);
+    pending.FragmentShader = CompileShader(GL_FRAGMENT_SHADER, source.FragmentSource);
 
-    GLCall(glAttachShader(program, vs));
-    GLCall(glAttachShader(program, fs));
-    GLCall(glLinkProgram(program));
-    GLCall(glValidateProgram(program));
+    // Le avisa al driver que vamos a pedir el binario, para que lo conserve despus de enlazar
+    if (ShaderCache::IsEnabled())
+    {
+        GLCall(glProgramParameteri(pending.Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
 
-    GLCall(glDeleteShader(vs));
-    GLCall(glDeleteShader(fs));
+    GLCall(glAttachShader(pending.Program, pending.VertexShader));
+    GLCall(glAttachShader(pending.Program, pending.FragmentShader));
+    GLCall(glLinkProgram(pending.Program));
 
-    return program;
+    return pending;
 }
 
-ShaderProgramSource Shader::ParseShader(const std::string& filepath)
+bool Shader::IsProgramReady(const PendingProgram& pending)
 {
-    std::ifstream stream(filepath);
+    if (!g_GLCaps.ParallelShaderCompile)
+        return true;
 
-    enum class ShaderType
-    {
-        NONE = -1, VERTEX = 0, FRAGMENT = 1
-    };
+    int completed;
+    GLCall(glGetProgramiv(pending.Program, GL_COMPLETION_STATUS_KHR, &completed));
+    return completed == GL_TRUE;
+}
 
-    std::string line;
-    std::stringstream ss[2];
-    ShaderType type = ShaderType::NONE;
-    while (getline(stream, line))
+unsigned int Shader::FinishProgram(PendingProgram& pending)
+{
+    int linked;
+    GLCall(glGetProgramiv(pending.Program, GL_LINK_STATUS, &linked));
+    if (linked == GL_FALSE)
     {
-        if (line.find("#shader") != std::string::npos)
-        {
-            if (line.find("vertex") != std::string::npos)
-                type = ShaderType::VERTEX;
-            else if (line.find("fragment") != std::string::npos)
-                type = ShaderType::FRAGMENT;
-        }
-        else
+        // Si fall alguna etapa, su log es ms til que el del enlace
+        bool compiled = CheckCompileStatus(pending.VertexShader, GL_VERTEX_SHADER);
+        compiled &= CheckCompileStatus(pending.FragmentShader, GL_FRAGMENT_SHADER);
+        if (compiled)
         {
-            ss[(int)type] << line << '\n';
+            int length;
+            GLCall(glGetProgramiv(pending.Program, GL_INFO_LOG_LENGTH, &length));
+            char* message = (char*)alloca((length + 1) * sizeof(char));
+            message[0] = '\0';
+            GLCall(glGetProgramInfoLog(pending.Program, length, &length, message));
+            std::cout << "Failed to link program!" << std::endl;
+            std::cout << message << std::endl;
         }
     }
+#ifdef _DEBUG
+    else
+    {
+        // Solo informa problemas en el log y obliga al driver a terminar el enlace, as que no va en release
+        GLCall(glValidateProgram(pending.Program));
+    }
+#endif
+
+    GLCall(glDetachShader(pending.Program, pending.VertexShader));
+    GLCall(glDetachShader(pending.Program, pending.FragmentShader));
+    GLCall(glDeleteShader(pending.VertexShader));
+    GLCall(glDeleteShader(pending.FragmentShader));
+
+    if (linked == GL_FALSE)
+    {
+        GLCall(glDeleteProgram(pending.Program));
+        return 0;
+    }
+
+    return pending.Program;
+}
+
+unsigned int Shader::CreateShader(const std::string& vertexShader, const std::string& fragmentShader)
+{
+    PROFILE_SCOPE("Shader::CreateShader");
 
-    return { ss[0].str(), ss[1].str() };
+    PendingProgram pending = BeginProgram({ vertexShader, fragmentShader });
+    return FinishProgram(pending);
 }
@@ -1,41 +1,195 @@
 #pragma once
 
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include "glm/glm.hpp"
 
-struct ShaderProgramSource
+#include "ShaderPreprocessor.h"
+
+/// <summary>
+/// Referencia a un uniform ya resuelta. Se obtiene una sola vez con Shader::GetUniform y despus
+/// los SetUniform que la reciben van directo al arreglo de ubicaciones, sin strings ni bsquedas.
+/// </summary>
+struct UniformHandle
+{
+	int Index = -1;
+
+	inline bool IsValid() const { return Index >= 0; }
+};
+
+enum class ShaderResourceKind
+{
+	Attribute, Uniform, UniformBlock
+};
+
+/// <summary>
+/// Entrada de la tabla de reflexin de un programa: un atributo, uniform o bloque de uniforms activo.
+/// </summary>
+struct ShaderResource
 {
-	std::string VertexSource;
-	std::string FragmentSource;
+	ShaderResourceKind Kind;
+	std::string Name;
+	// Ubicacin del atributo o uniform (-1 para los uniforms que estn dentro de un bloque). En los bloques, el punto de enlace
+	int Location;
+	// Tipo GLSL (GL_FLOAT_VEC4, GL_FLOAT_MAT4, GL_SAMPLER_2D...). 0 en los bloques
+	unsigned int Type;
+	// Cantidad de elementos si es un arreglo, si no 1. En los bloques, el tamao en bytes
+	int Size;
 };
 
 class Shader
 {
+	// Crea los Shader a partir de programas que empez a enlazar por su cuenta
+	friend class ShaderLibrary;
+
 private:
 	std::string m_FilePath;
 	unsigned int m_RendererID;
 
-	// Mapa para guardar los valores "location" de uniform para no consultar su ubicacin una y otra vez, en GetUniformLocation, a la GPU
-	mutable std::unordered_map<std::string, int> m_UniformLocationCache;
+	// Claves con las que se preproces esta variante, y lo que declar el archivo (ver ShaderPreprocessor)
+	std::vector<std::string> m_Defines;
+	std::vector<std::string> m_Features;
+	std::vector<std::string> m_Files;
+
+	// Variantes ya compiladas, por mscara de bits sobre m_Features
+	std::vector<std::pair<uint32_t, std::unique_ptr<Shader>>> m_Variants;
+
+	// Todo lo activo en el programa, ordenado por tipo y nombre. Se arma una sola vez despus de cada enlace
+	std::vector<ShaderResource> m_Resources;
+
+	/*
+		Tabla de uniforms: el ndice de un UniformHandle vale para los dos arreglos. Los nombres se registran una
+		sola vez; si el programa se vuelve a enlazar solo se recalculan las ubicaciones, as que los handles siguen valiendo.
+	*/
+	std::vector<std::string> m_UniformNames;
+	std::vector<int> m_UniformLocations;
+	// Tipo GLSL (GL_FLOAT_MAT4, GL_SAMPLER_2D...) segn glGetActiveUniform. 0 si no est activo en el programa
+	std::vector<unsigned int> m_UniformTypes;
+
+	// ltimo valor subido de cada uniform, para no repetir la llamada si no cambi. Alcanza para un mat4
+	struct alignas(16) UniformValue
+	{
+		float Data[16];
+	};
+	std::vector<UniformValue> m_UniformValues;
+	// Bytes guardados en m_UniformValues. 0 significa que no se conoce el valor que tiene el programa
+	std::vector<unsigned char> m_UniformValueSizes;
+
+	// Programa que se est compilando y enlazando sin bloquear. Los shaders quedan adjuntos hasta FinishProgram
+	struct PendingProgram
+	{
+		unsigned int Program = 0;
+		unsigned int VertexShader = 0;
+		unsigned int FragmentShader = 0;
+		uint64_t CacheKey = 0;
+	};
+
+	// Recarga en curso. Mientras tanto se sigue dibujando con m_RendererID
+	PendingProgram m_Reload;
+	/*
+		Lo que ley la recarga en curso, o la ltima que no compil. Recin pasa a m_Defines, m_Features y m_Files
+		cuando el programa nuevo enlaza; mientras tanto sus archivos tambin se vigilan, para que arreglar un
+		#include nuevo que fall vuelva a disparar la recarga.
+	*/
+	PreprocessedShader m_ReloadSource;
 
 public:
-	Shader(const std::string& filepath);
+	struct UniformStats
+	{
+		// SetUniform que no llegaron al driver porque el valor era el mismo que el programa ya tena
+		unsigned int Skipped = 0;
+		unsigned int Issued = 0;
+	};
+
+	Shader(const std::string& filepath, const std::vector<std::string>& defines = {});
 	~Shader();
 
 	void Bind() const;
 	void Unbind() const;
 
-	// Set uniforms
-	void SetUniform1i(const std::string& name, int value);
-	void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
-	void SetUniformMat4f(const std::string& name, const glm::mat4& matrix);
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline const std::string& GetFilePath() const { return m_FilePath; }
+	inline const std::vector<std::string>& GetFeatures() const { return m_Features; }
+
+	/// <summary>
+	/// Devuelve la variante del shader con las claves "features" definidas, por ejemplo GetVariant({ "USE_TEXTURE" }).
+	/// Las claves tienen que estar declaradas con #feature en el archivo. Cada combinacin se compila la primera vez
+	/// que se pide y queda guardada en este Shader, que es su dueo. Sin claves devuelve el mismo Shader.
+	/// </summary>
+	Shader& GetVariant(std::initializer_list<const char*> features);
+
+	/// <summary>
+	/// Vuelve a leer el archivo y empieza a compilarlo sin esperar al driver. El programa actual se sigue usando
+	/// hasta que el nuevo termina de enlazar; recin ah UpdateReloads los intercambia. Si el nuevo no compila,
+	/// se informa el error y queda el anterior.
+	/// </summary>
+	void Reload();
+	inline bool IsReloading() const { return m_Reload.Program != 0; }
+
+	// Recarga todos los Shader creados a partir de "filepath" o que lo incluyen
+	static void ReloadFile(const std::string& filepath);
+
+	// Revisa las recargas en curso de todos los Shader. Se llama una vez por frame, antes de dibujar
+	static void UpdateReloads();
+
+	inline const std::vector<ShaderResource>& GetResources() const { return m_Resources; }
+
+	// Bsqueda binaria en la tabla de reflexin. nullptr si el programa no tiene ese recurso activo
+	const ShaderResource* FindResource(ShaderResourceKind kind, const std::string& name) const;
+
+	/// <summary>
+	/// Busca un uniform por nombre y devuelve un handle para usar en los SetUniform. La bsqueda se hace
+	/// ac, as que conviene pedir el handle al crear el objeto y no en cada frame.
+	/// </summary>
+	UniformHandle GetUniform(const char* name);
+
+	/// <summary>
+	/// Enlaza el bloque de uniforms "blockName" al punto "binding", del que lee el UniformBuffer enlazado ah.
+	/// Los bloques "Camera" y "Object" se enlazan solos a UniformBuffer::CameraBinding y ObjectBinding.
+	/// </summary>
+	/// <returns>false si el programa no tiene un bloque activo con ese nombre</returns>
+	bool BindUniformBlock(const char* blockName, unsigned int binding);
+
+	// Set uniforms. Con DSA no hace falta llamar antes a Bind; sin DSA el valor va al programa en uso
+	void SetUniform1i(UniformHandle uniform, int value);
+	void SetUniform1iv(UniformHandle uniform, int count, const int* values);
+	void SetUniform4f(UniformHandle uniform, float v0, float v1, float v2, float v3);
+	void SetUniformMat4f(UniformHandle uniform, const glm::mat4& matrix);
+
+	// Versiones por nombre, para usos ocasionales. Cada llamada busca el nombre en la tabla
+	void SetUniform1i(const char* name, int value);
+	void SetUniform1iv(const char* name, int count, const int* values);
+	void SetUniform4f(const char* name, float v0, float v1, float v2, float v3);
+	void SetUniformMat4f(const char* name, const glm::mat4& matrix);
+
+	// Contadores de todos los shaders desde el ltimo ResetUniformStats
+	static const UniformStats& GetUniformStats();
+	static void ResetUniformStats();
 
 private:
-	ShaderProgramSource ParseShader(const std::string& filepath);
+	// Adopta un programa ya enlazado, o 0 si no compil
+	Shader(const PreprocessedShader& shader, unsigned int program);
+
+	void SetSource(const PreprocessedShader& shader);
 
-	unsigned int CompileShader(unsigned int type, const std::string& source);
+	// Crea y compila un shader sin consultar el resultado, para no obligar al driver a terminar ahora
+	static unsigned int CompileShader(unsigned int type, const std::string& source);
+
+	// Empieza a compilar y enlazar un programa. Ninguna de las llamadas espera a que el driver termine
+	static PendingProgram BeginProgram(const ShaderProgramSource& source);
+
+	// Con GL_KHR_parallel_shader_compile pregunta sin bloquear si el programa termin; sin la extensin siempre es true
+	static bool IsProgramReady(const PendingProgram& pending);
+
+	/// <summary>
+	/// Revisa el resultado de la compilacin y el enlace, muestra los errores si los hubo y libera los shaders
+	/// </summary>
+	/// <returns>El programa enlazado, o 0 si fall</returns>
+	static unsigned int FinishProgram(PendingProgram& pending);
 
 	/// <summary>
 	/// El propsito de esta funcin es proveer a OpenGL el cdigo fuente del shader real,
@@ -45,7 +199,26 @@ private:
 	/// <param name="vertexShader"></param>
 	/// <param name="fragmentShader"></param>
 	/// <returns>Algn identificador nico para ese shader creado para que podamos luego asociarlo y usarlo</returns>
-	unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
+	static unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
+
+	// Reemplaza el programa por uno recin enlazado a partir de "source", adopta sus claves y archivos
+	// y le vuelve a subir los valores de uniforms conocidos
+	void SwapProgram(unsigned int program, const PreprocessedShader& source);
+
+	// Enumera los atributos, uniforms y bloques activos del programa en m_Resources
+	void Reflect();
+
+	// Enlaza los bloques conocidos, arma la reflexin y llena la tabla de uniforms a partir de ella
+	void ResolveUniforms();
+
+	UniformHandle AddUniform(const std::string& name, int location);
+
+	/// <summary>
+	/// Compara "value" con el ltimo valor subido al uniform. Si son iguales no hace falta la llamada;
+	/// si no, guarda el nuevo valor como el ltimo subido.
+	/// </summary>
+	/// <returns>true si hay que llamar a glUniform*</returns>
+	bool ShouldUpload(UniformHandle uniform, const void* value, unsigned int size);
 
-	int GetUniformLocation(const std::string& name) const;
+	inline int GetLocation(UniformHandle uniform) const { return uniform.IsValid() ? m_UniformLocations[uniform.Index] : -1; }
 };
\ No newline at end of file
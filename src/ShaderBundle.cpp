@@ -0,0 +1,161 @@
+#include "ShaderBundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// El archivo entero tal como est en disco; las entradas y los strings apuntan adentro
+static std::vector<char> s_Data;
+static const ShaderBundle::Entry* s_Entries = nullptr;
+static uint32_t s_EntryCount = 0;
+static const char* s_Strings = nullptr;
+
+static uint64_t HashBytes(uint64_t hash, const char* data, size_t size)
+{
+	// FNV-1a de 64 bits, como en ShaderCache
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= (unsigned char)data[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+static std::vector<std::string> SplitLines(const char* data, uint32_t size)
+{
+	std::vector<std::string> lines;
+	const char* end = data + size;
+	while (data < end)
+	{
+		const char* newline = std::find(data, end, '\n');
+		lines.emplace_back(data, newline);
+		data = newline + 1;
+	}
+	return lines;
+}
+
+uint64_t ShaderBundle::MakeKey(const std::string& filepath, const std::vector<std::string>& defines)
+{
+	std::string path = std::filesystem::path(filepath).lexically_normal().generic_string();
+	uint64_t hash = HashBytes(14695981039346656037ull, path.c_str(), path.size() + 1);
+	for (const std::string& define : defines)
+		hash = HashBytes(hash, define.c_str(), define.size() + 1);
+	return hash;
+}
+
+bool ShaderBundle::Open(const std::string& path)
+{
+	Close();
+
+	std::ifstream stream(path, std::ios::binary | std::ios::ate);
+	if (!stream)
+		return false;
+
+	s_Data.resize((size_t)stream.tellg());
+	stream.seekg(0);
+	if (!stream.read(s_Data.data(), s_Data.size()) || s_Data.size() < sizeof(Header))
+	{
+		Close();
+		return false;
+	}
+
+	Header header;
+	std::memcpy(&header, s_Data.data(), sizeof(header));
+	size_t expected = sizeof(Header) + (size_t)header.EntryCount * sizeof(Entry) + header.StringsSize;
+	if (header.Magic != Magic || header.Version != FormatVersion || s_Data.size() != expected)
+	{
+		std::cout << "ShaderBundle: '" << path << "' is not a valid bundle, shaders will be read from source" << std::endl;
+		Close();
+		return false;
+	}
+
+	s_Entries = (const Entry*)(s_Data.data() + sizeof(Header));
+	s_EntryCount = header.EntryCount;
+	s_Strings = (const char*)(s_Entries + s_EntryCount);
+	return true;
+}
+
+bool ShaderBundle::IsOpen()
+{
+	return s_Entries != nullptr;
+}
+
+void ShaderBundle::Close()
+{
+	s_Data.clear();
+	s_Data.shrink_to_fit();
+	s_Entries = nullptr;
+	s_EntryCount = 0;
+	s_Strings = nullptr;
+}
+
+PreprocessedShader ShaderBundle::Load(const std::string& filepath, const std::vector<std::string>& defines)
+{
+	if (!IsOpen())
+		return ShaderPreprocessor::Process(filepath, defines);
+
+	uint64_t key = MakeKey(filepath, defines);
+	const Entry* end = s_Entries + s_EntryCount;
+	const Entry* entry = std::lower_bound(s_Entries, end, key, [](const Entry& entry, uint64_t key) { return entry.Key < key; });
+	if (entry == end || entry->Key != key)
+		return ShaderPreprocessor::Process(filepath, defines);
+
+	PreprocessedShader shader;
+	shader.FilePath = filepath;
+	shader.Defines = defines;
+	shader.Source.VertexSource.assign(s_Strings + entry->VertexSource.Offset, entry->VertexSource.Size);
+	shader.Source.FragmentSource.assign(s_Strings + entry->FragmentSource.Offset, entry->FragmentSource.Size);
+	shader.Features = SplitLines(s_Strings + entry->Features.Offset, entry->Features.Size);
+	shader.Files = SplitLines(s_Strings + entry->Files.Offset, entry->Files.Size);
+	return shader;
+}
+
+bool ShaderBundle::Write(const std::string& path, const std::vector<PreprocessedShader>& shaders)
+{
+	std::vector<Entry> entries;
+	std::string strings;
+
+	auto addString = [&strings](const std::string& value)
+	{
+		String string = { (uint32_t)strings.size(), (uint32_t)value.size() };
+		strings += value;
+		return string;
+	};
+	auto addList = [&addString](const std::vector<std::string>& values)
+	{
+		std::string joined;
+		for (size_t i = 0; i < values.size(); i++)
+			joined += (i ? "\n" : "") + values[i];
+		return addString(joined);
+	};
+
+	for (const PreprocessedShader& shader : shaders)
+	{
+		Entry entry;
+		entry.Key = MakeKey(shader.FilePath, shader.Defines);
+		entry.VertexSource = addString(shader.Source.VertexSource);
+		entry.FragmentSource = addString(shader.Source.FragmentSource);
+		entry.Features = addList(shader.Features);
+		entry.Files = addList(shader.Files);
+		entries.push_back(entry);
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.Key < b.Key; });
+	for (size_t i = 1; i < entries.size(); i++)
+	{
+		if (entries[i].Key == entries[i - 1].Key)
+		{
+			std::cout << "ShaderBundle: two entries share the same key" << std::endl;
+			return false;
+		}
+	}
+
+	std::ofstream stream(path, std::ios::binary);
+	Header header = { Magic, FormatVersion, (uint32_t)entries.size(), (uint32_t)strings.size() };
+	stream.write((const char*)&header, sizeof(header));
+	stream.write((const char*)entries.data(), entries.size() * sizeof(Entry));
+	stream.write(strings.data(), strings.size());
+	return (bool)stream;
+}
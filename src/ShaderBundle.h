@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ShaderPreprocessor.h"
+
+/// <summary>
+/// Paquete de shaders ya preprocesados que arma la herramienta shader_cook a partir de res/shaders. Cada
+/// entrada tiene el cdigo de las dos etapas, separado y sin comentarios, y se busca por un hash de la ruta
+/// y las claves de la variante. Open lee el archivo entero de una sola vez; despus Load no toca el disco
+/// ni vuelve a parsear nada. Si no hay paquete o la entrada no est, Load preprocesa el archivo como siempre.
+/// </summary>
+class ShaderBundle
+{
+public:
+	static const uint32_t Magic = 0x42534c47; // "GLSB"
+	static const uint32_t FormatVersion = 1;
+
+	struct Header
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint32_t EntryCount;
+		// Bytes de la tabla de strings, que va despus de las entradas
+		uint32_t StringsSize;
+	};
+
+	// Tramo de la tabla de strings
+	struct String
+	{
+		uint32_t Offset;
+		uint32_t Size;
+	};
+
+	// Las entradas van ordenadas por Key para buscarlas con bsqueda binaria
+	struct Entry
+	{
+		uint64_t Key;
+		String VertexSource;
+		String FragmentSource;
+		// Listas separadas por '\n'
+		String Features;
+		String Files;
+	};
+
+	static uint64_t MakeKey(const std::string& filepath, const std::vector<std::string>& defines);
+
+	static bool Open(const std::string& path);
+	static void Close();
+	static bool IsOpen();
+
+	// Busca la variante en el paquete abierto; si no est, la preprocesa desde el archivo
+	static PreprocessedShader Load(const std::string& filepath, const std::vector<std::string>& defines);
+
+	/// <summary>
+	/// Escribe un paquete con "shaders". Lo usa shader_cook; la aplicacin solo lee.
+	/// </summary>
+	static bool Write(const std::string& path, const std::vector<PreprocessedShader>& shaders);
+};
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "ShaderCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "Renderer.h"
+#include "Shader.h"
+#include "Profiler.h"
+
+struct ProgramBinaryHeader
+{
+	uint32_t Magic;
+	uint32_t Format;
+	// Se repite la clave para descartar archivos que no corresponden aunque coincida el nombre
+	uint64_t Key;
+};
+
+static const uint32_t s_Magic = 0x42504c47; // "GLPB"
+
+static std::string s_Directory = "shader_cache";
+static bool s_Enabled = true;
+static ShaderCache::Stats s_Stats;
+
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+	// FNV-1a de 64 bits: alcanza para distinguir fuentes y es trivial de calcular
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ bytes[i]) * 1099511628211ull;
+	return hash;
+}
+
+static uint64_t HashString(uint64_t hash, const char* string)
+{
+	// Se incluye el terminador para que "ab" + "c" no d lo mismo que "a" + "bc"
+	if (!string)
+		string = "";
+	return HashBytes(hash, string, std::strlen(string) + 1);
+}
+
+void ShaderCache::SetDirectory(const std::string& directory)
+{
+	s_Directory = directory;
+}
+
+void ShaderCache::SetEnabled(bool enabled)
+{
+	s_Enabled = enabled;
+}
+
+bool ShaderCache::IsEnabled()
+{
+	return s_Enabled && g_GLCaps.ProgramBinary;
+}
+
+uint64_t ShaderCache::MakeKey(const ShaderProgramSource& source)
+{
+	uint64_t hash = 14695981039346656037ull;
+
+	// Un binario solo sirve para el mismo driver que lo gener
+	GLCall(hash = HashString(hash, (const char*)glGetString(GL_VENDOR)));
+	GLCall(hash = HashString(hash, (const char*)glGetString(GL_RENDERER)));
+	GLCall(hash = HashString(hash, (const char*)glGetString(GL_VERSION)));
+
+	hash = HashString(hash, source.VertexSource.c_str());
+	hash = HashString(hash, source.FragmentSource.c_str());
+	return hash;
+}
+
+std::string ShaderCache::GetPath(uint64_t key)
+{
+	char name[32];
+	std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+	return s_Directory + "/" + name;
+}
+
+unsigned int ShaderCache::Load(uint64_t key)
+{
+	if (!IsEnabled())
+		return 0;
+
+	PROFILE_SCOPE("ShaderCache::Load");
+
+	std::string path = GetPath(key);
+	std::ifstream stream(path, std::ios::binary | std::ios::ate);
+	if (!stream)
+		return 0;
+
+	std::streamoff size = stream.tellg();
+	ProgramBinaryHeader header;
+	if (size <= (std::streamoff)sizeof(header))
+		return 0;
+
+	std::vector<char> binary((size_t)size - sizeof(header));
+	stream.seekg(0);
+	stream.read((char*)&header, sizeof(header));
+	stream.read(binary.data(), binary.size());
+	if (!stream || header.Magic != s_Magic || header.Key != key)
+		return 0;
+
+	GLCall(unsigned int program = glCreateProgram());
+	GLCall(glProgramBinary(program, header.Format, binary.data(), (GLsizei)binary.size()));
+
+	int status;
+	GLCall(glGetProgramiv(program, GL_LINK_STATUS, &status));
+	if (status == GL_FALSE)
+	{
+		// El driver puede rechazar binarios viejos aunque la versin no haya cambiado
+		GLCall(glDeleteProgram(program));
+		stream.close();
+		std::error_code error;
+		std::filesystem::remove(path, error);
+		s_Stats.Rejected++;
+		return 0;
+	}
+
+	return program;
+}
+
+void ShaderCache::Store(uint64_t key, unsigned int program)
+{
+	if (!IsEnabled())
+		return;
+
+	int status, length;
+	GLCall(glGetProgramiv(program, GL_LINK_STATUS, &status));
+	GLCall(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+	if (status == GL_FALSE || length <= 0)
+		return;
+
+	ProgramBinaryHeader header = { s_Magic, 0, key };
+	std::vector<char> binary(length);
+	GLCall(glGetProgramBinary(program, length, &length, &header.Format, binary.data()));
+
+	std::error_code error;
+	std::filesystem::create_directories(s_Directory, error);
+
+	std::ofstream stream(GetPath(key), std::ios::binary);
+	stream.write((const char*)&header, sizeof(header));
+	stream.write(binary.data(), length);
+}
+
+void ShaderCache::RecordLoad(bool hit, double milliseconds)
+{
+	if (hit)
+	{
+		s_Stats.Hits++;
+		s_Stats.HitTime += milliseconds;
+	}
+	else
+	{
+		s_Stats.Misses++;
+		s_Stats.MissTime += milliseconds;
+	}
+}
+
+const ShaderCache::Stats& ShaderCache::GetStats()
+{
+	return s_Stats;
+}
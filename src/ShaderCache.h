@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+struct ShaderProgramSource;
+
+/// <summary>
+/// Cach en disco de programas ya enlazados. Cada programa se guarda con glGetProgramBinary en un archivo
+/// cuyo nombre es un hash del cdigo fuente y del driver (vendor, renderer y versin), as que cambiar
+/// el shader o actualizar el driver invalida la entrada sola. Si el driver rechaza un binario, se borra el
+/// archivo y el Shader vuelve a compilar desde el cdigo fuente.
+/// </summary>
+class ShaderCache
+{
+public:
+	struct Stats
+	{
+		unsigned int Hits = 0;
+		unsigned int Misses = 0;
+		// Binarios que estaban en disco pero el driver no acept. Tambin cuentan como Misses
+		unsigned int Rejected = 0;
+		// Milisegundos totales que tardaron en crearse los programas en cada caso
+		double HitTime = 0.0;
+		double MissTime = 0.0;
+	};
+
+	static void SetDirectory(const std::string& directory);
+	static void SetEnabled(bool enabled);
+	static bool IsEnabled();
+
+	static uint64_t MakeKey(const ShaderProgramSource& source);
+
+	/// <returns>Un programa enlazado a partir del binario guardado, o 0 si no hay o el driver lo rechaz</returns>
+	static unsigned int Load(uint64_t key);
+
+	// Guarda el binario de un programa recin enlazado. No hace nada si el enlace fall
+	static void Store(uint64_t key, unsigned int program);
+
+	static void RecordLoad(bool hit, double milliseconds);
+	static const Stats& GetStats();
+
+private:
+	static std::string GetPath(uint64_t key);
+};
\ No newline at end of file
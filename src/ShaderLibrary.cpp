@@ -0,0 +1,144 @@
+#include "ShaderLibrary.h"
+
+#include <memory>
+#include <vector>
+
+#include "Renderer.h"
+#include "Shader.h"
+#include "ShaderCache.h"
+#include "ShaderBundle.h"
+#include "Profiler.h"
+
+struct ShaderLibrary::Entry
+{
+	std::string FilePath;
+	std::unique_ptr<Shader> Instance;
+
+	bool Started = false;
+	// Programa cargado desde la cach de binarios; si es 0 se est enlazando en Pending
+	unsigned int CachedProgram = 0;
+	Shader::PendingProgram Pending;
+	PreprocessedShader Source;
+	// Microsegundos que llev mandar a compilar, para sumarlos al tiempo de carga en ShaderCache
+	double StartTime = 0.0;
+};
+
+static std::vector<std::unique_ptr<ShaderLibrary::Entry>> s_Entries;
+static ShaderLibrary::Stats s_Stats;
+
+ShaderLibrary::Entry& ShaderLibrary::Find(const std::string& filepath)
+{
+	for (const auto& entry : s_Entries)
+	{
+		if (entry->FilePath == filepath)
+			return *entry;
+	}
+
+	s_Entries.push_back(std::make_unique<Entry>());
+	s_Entries.back()->FilePath = filepath;
+	return *s_Entries.back();
+}
+
+void ShaderLibrary::Start(Entry& entry)
+{
+	double start = Profiler::Now();
+	entry.Source = ShaderBundle::Load(entry.FilePath, {});
+	uint64_t key = ShaderCache::MakeKey(entry.Source.Source);
+	entry.CachedProgram = ShaderCache::Load(key);
+	if (!entry.CachedProgram)
+	{
+		entry.Pending = Shader::BeginProgram(entry.Source.Source);
+		entry.Pending.CacheKey = key;
+	}
+
+	entry.Started = true;
+	entry.StartTime = Profiler::Now() - start;
+}
+
+void ShaderLibrary::Register(const std::string& filepath)
+{
+	Find(filepath);
+}
+
+void ShaderLibrary::CompileAll()
+{
+	PROFILE_SCOPE("ShaderLibrary::CompileAll");
+
+	double start = Profiler::Now();
+	for (const auto& entry : s_Entries)
+	{
+		if (entry->Started)
+			continue;
+
+		Start(*entry);
+		s_Stats.Submitted++;
+	}
+
+	s_Stats.SubmitTime += (Profiler::Now() - start) / 1000.0;
+}
+
+bool ShaderLibrary::IsReady(const std::string& filepath)
+{
+	Entry& entry = Find(filepath);
+	if (entry.Instance || entry.CachedProgram)
+		return true;
+
+	// Sin GL_KHR_parallel_shader_compile no hay forma de preguntar sin bloquear, y el primer Get va a esperar al enlace
+	if (!entry.Started || !g_GLCaps.ParallelShaderCompile)
+		return false;
+
+	return Shader::IsProgramReady(entry.Pending);
+}
+
+Shader& ShaderLibrary::Get(const std::string& filepath)
+{
+	Entry& entry = Find(filepath);
+	if (entry.Instance)
+		return *entry.Instance;
+
+	if (!entry.Started)
+		Start(entry);
+
+	// Ac se consulta el estado del enlace por primera vez; si el driver no termin, se espera solo a este programa
+	double start = Profiler::Now();
+	bool hit = entry.CachedProgram != 0;
+	unsigned int program = entry.CachedProgram;
+	if (!hit)
+	{
+		PROFILE_SCOPE("Shader::FinishProgram");
+		program = Shader::FinishProgram(entry.Pending);
+		if (program)
+			ShaderCache::Store(entry.Pending.CacheKey, program);
+		entry.Pending = Shader::PendingProgram();
+	}
+
+	entry.Instance.reset(new Shader(entry.Source, program));
+
+	ShaderCache::RecordLoad(hit, (entry.StartTime + Profiler::Now() - start) / 1000.0);
+
+	return *entry.Instance;
+}
+
+const ShaderLibrary::Stats& ShaderLibrary::GetStats()
+{
+	return s_Stats;
+}
+
+void ShaderLibrary::Shutdown()
+{
+	for (const auto& entry : s_Entries)
+	{
+		// Programas que se mandaron a compilar pero nadie lleg a pedir
+		if (entry->Pending.Program)
+		{
+			unsigned int program = Shader::FinishProgram(entry->Pending);
+			GLCall(glDeleteProgram(program));
+		}
+		else if (entry->CachedProgram && !entry->Instance)
+		{
+			GLCall(glDeleteProgram(entry->CachedProgram));
+		}
+	}
+
+	s_Entries.clear();
+}
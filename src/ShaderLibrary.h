@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+
+class Shader;
+
+/// <summary>
+/// Duea de los Shader de la aplicacin, identificados por la ruta del archivo. CompileAll manda a compilar
+/// y enlazar todos los registrados de una vez, sin esperar ninguno; con GL_KHR_parallel_shader_compile el
+/// driver los procesa en paralelo. El resultado (y el log si fall) recin se consulta en el primer Get,
+/// que solo bloquea si ese programa todava no termin.
+/// </summary>
+class ShaderLibrary
+{
+public:
+	// Definida en ShaderLibrary.cpp
+	struct Entry;
+
+	struct Stats
+	{
+		// Programas que CompileAll mand a compilar, y milisegundos que tard en mandarlos sin esperar al driver
+		unsigned int Submitted = 0;
+		double SubmitTime = 0.0;
+	};
+
+private:
+	static Entry& Find(const std::string& filepath);
+	static void Start(Entry& entry);
+public:
+	static void Register(const std::string& filepath);
+
+	// Empieza a compilar todos los shaders registrados que todava no se empezaron
+	static void CompileAll();
+
+	// true si Get no va a tener que esperar al driver. Sin GL_KHR_parallel_shader_compile solo lo es si ya est enlazado
+	// (porque ya se pidi con Get o vino de la cach de binarios)
+	static bool IsReady(const std::string& filepath);
+
+	/// <summary>
+	/// Devuelve el Shader de "filepath". Si no estaba registrado lo registra y lo compila en el momento.
+	/// La referencia vale hasta Shutdown.
+	/// </summary>
+	static Shader& Get(const std::string& filepath);
+
+	static const Stats& GetStats();
+
+	// Borra todos los Shader. Se llama antes de destruir el contexto
+	static void Shutdown();
+};
\ No newline at end of file
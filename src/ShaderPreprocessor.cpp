@@ -0,0 +1,142 @@
+#include "ShaderPreprocessor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+	enum class ShaderType
+	{
+		NONE = -1, VERTEX = 0, FRAGMENT = 1
+	};
+
+	struct PreprocessState
+	{
+		PreprocessedShader& Result;
+		ShaderType Type = ShaderType::NONE;
+		std::stringstream Stages[2];
+		bool DefinesInjected[2] = { false, false };
+		// Archivos ya pegados en la etapa actual
+		std::vector<std::string> Included;
+
+		PreprocessState(PreprocessedShader& result)
+			: Result(result) {}
+	};
+
+	// Si la lnea empieza (salvo espacios) con la directiva, devuelve el resto de la lnea; si no, nullptr
+	const char* MatchDirective(const std::string& line, const char* directive)
+	{
+		size_t start = line.find_first_not_of(" \t");
+		size_t length = std::strlen(directive);
+		if (start == std::string::npos || line.compare(start, length, directive) != 0)
+			return nullptr;
+
+		const char* rest = line.c_str() + start + length;
+		while (*rest == ' ' || *rest == '\t')
+			rest++;
+		return rest;
+	}
+
+	void InjectDefines(PreprocessState& state)
+	{
+		std::stringstream& stage = state.Stages[(int)state.Type];
+		for (const std::string& define : state.Result.Defines)
+			stage << "#define " << define << '\n';
+		state.DefinesInjected[(int)state.Type] = true;
+	}
+
+	bool ProcessFile(PreprocessState& state, const std::filesystem::path& path)
+	{
+		std::ifstream stream(path);
+		if (!stream)
+			return false;
+
+		std::string file = path.generic_string();
+		if (std::find(state.Result.Files.begin(), state.Result.Files.end(), file) == state.Result.Files.end())
+			state.Result.Files.push_back(file);
+
+		std::string line;
+		unsigned int lineNumber = 0;
+		while (getline(stream, line))
+		{
+			lineNumber++;
+			const char* argument;
+			if ((argument = MatchDirective(line, "#shader")))
+			{
+				if (std::strstr(argument, "vertex"))
+					state.Type = ShaderType::VERTEX;
+				else if (std::strstr(argument, "fragment"))
+					state.Type = ShaderType::FRAGMENT;
+				state.Included.clear();
+			}
+			else if ((argument = MatchDirective(line, "#feature")))
+			{
+				std::string feature = argument;
+				feature.erase(feature.find_last_not_of(" \t\r") + 1);
+				std::vector<std::string>& features = state.Result.Features;
+				if (std::find(features.begin(), features.end(), feature) != features.end())
+					continue;
+
+				if (features.size() < ShaderPreprocessor::MaxFeatures)
+					features.push_back(feature);
+				else
+					std::cout << "ShaderPreprocessor: too many features in '" << file << "', ignoring " << feature << std::endl;
+			}
+			else if (state.Type == ShaderType::NONE)
+			{
+				// Lo que haya antes del primer #shader no pertenece a ninguna etapa
+			}
+			else if ((argument = MatchDirective(line, "#include")))
+			{
+				const char* begin = std::strpbrk(argument, "\"<");
+				const char* end = begin ? std::strpbrk(begin + 1, "\">") : nullptr;
+				if (!end)
+				{
+					std::cout << "ShaderPreprocessor: malformed #include in '" << file << "':" << lineNumber << std::endl;
+					continue;
+				}
+
+				std::filesystem::path included = (path.parent_path() / std::string(begin + 1, end)).lexically_normal();
+				if (std::find(state.Included.begin(), state.Included.end(), included.generic_string()) != state.Included.end())
+					continue;
+				state.Included.push_back(included.generic_string());
+
+				if (!ProcessFile(state, included))
+					std::cout << "ShaderPreprocessor: can't open '" << included.generic_string() << "' (included from '" << file << "':" << lineNumber << ")" << std::endl;
+			}
+			else
+			{
+				std::stringstream& stage = state.Stages[(int)state.Type];
+				bool version = MatchDirective(line, "#version") != nullptr;
+				// Las claves van justo despus del #version, que tiene que ser la primera lnea de la etapa
+				if (!version && !state.DefinesInjected[(int)state.Type])
+					InjectDefines(state);
+
+				stage << line << '\n';
+				if (version)
+					InjectDefines(state);
+			}
+		}
+
+		return true;
+	}
+
+}
+
+PreprocessedShader ShaderPreprocessor::Process(const std::string& filepath, const std::vector<std::string>& defines)
+{
+	PreprocessedShader result;
+	result.FilePath = filepath;
+	result.Defines = defines;
+
+	PreprocessState state(result);
+	if (!ProcessFile(state, std::filesystem::path(filepath).lexically_normal()))
+		std::cout << "ShaderPreprocessor: can't open '" << filepath << "'" << std::endl;
+
+	result.Source = { state.Stages[0].str(), state.Stages[1].str() };
+	return result;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+struct ShaderProgramSource
+{
+	std::string VertexSource;
+	std::string FragmentSource;
+};
+
+/// <summary>
+/// Resultado de preprocesar un archivo .shader con un conjunto de claves definidas.
+/// </summary>
+struct PreprocessedShader
+{
+	std::string FilePath;
+	std::vector<std::string> Defines;
+	ShaderProgramSource Source;
+	// Claves declaradas con #feature, en orden de aparicin: la posicin es el bit en la mscara de variantes
+	std::vector<std::string> Features;
+	// El archivo principal y todos los que incluye, para saber qu shaders recargar cuando cambia alguno
+	std::vector<std::string> Files;
+};
+
+/// <summary>
+/// Arma el cdigo de cada etapa a partir de un archivo .shader. Adems de "#shader vertex/fragment" entiende:
+///		- #include "archivo": pega el archivo, buscado desde la carpeta del que lo incluye. Un mismo archivo
+///		  se pega una sola vez por etapa, as que no hacen falta guardas.
+///		- #feature CLAVE: declara una clave que se puede activar al pedir una variante del shader.
+/// Las claves activas se inyectan como "#define CLAVE" despus del #version de cada etapa, para usarlas con #ifdef.
+/// </summary>
+class ShaderPreprocessor
+{
+public:
+	// Mximo de claves por shader: las variantes se identifican con una mscara de 32 bits
+	static const unsigned int MaxFeatures = 32;
+
+	static PreprocessedShader Process(const std::string& filepath, const std::vector<std::string>& defines);
+};
\ No newline at end of file
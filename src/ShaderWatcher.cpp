@@ -0,0 +1,96 @@
+#include "ShaderWatcher.h"
+
+#include <algorithm>
+
+#include "Profiler.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <climits>
+#endif
+
+#ifdef __linux__
+
+ShaderWatcher::ShaderWatcher(const std::string& directory)
+	: m_Directory(directory), m_Watch(-1)
+{
+	m_Descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	// Los editores suelen guardar escribiendo un archivo temporal y renombrndolo, de ah IN_MOVED_TO
+	if (m_Descriptor != -1)
+		m_Watch = inotify_add_watch(m_Descriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+	if (m_Descriptor != -1)
+		close(m_Descriptor);
+}
+
+std::vector<std::string> ShaderWatcher::Poll()
+{
+	std::vector<std::string> changed;
+	if (m_Watch == -1)
+		return changed;
+
+	alignas(inotify_event) char buffer[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+	ssize_t length;
+	while ((length = read(m_Descriptor, buffer, sizeof(buffer))) > 0)
+	{
+		for (char* ptr = buffer; ptr < buffer + length; )
+		{
+			const inotify_event* event = (const inotify_event*)ptr;
+			if (event->len > 0)
+			{
+				std::string path = m_Directory + "/" + event->name;
+				if (std::find(changed.begin(), changed.end(), path) == changed.end())
+					changed.push_back(path);
+			}
+			ptr += sizeof(inotify_event) + event->len;
+		}
+	}
+
+	return changed;
+}
+
+#else
+
+ShaderWatcher::ShaderWatcher(const std::string& directory)
+	: m_Directory(directory), m_LastPoll(Profiler::Now())
+{
+	std::error_code error;
+	for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+		m_WriteTimes[entry.path().generic_string()] = entry.last_write_time(error);
+}
+
+ShaderWatcher::~ShaderWatcher()
+{
+}
+
+std::vector<std::string> ShaderWatcher::Poll()
+{
+	std::vector<std::string> changed;
+
+	// Recorrer el directorio cada frame sera un costo fijo por nada
+	double now = Profiler::Now();
+	if (now - m_LastPoll < 500000.0)
+		return changed;
+	m_LastPoll = now;
+
+	std::error_code error;
+	for (const auto& entry : std::filesystem::directory_iterator(m_Directory, error))
+	{
+		std::string path = entry.path().generic_string();
+		auto writeTime = entry.last_write_time(error);
+		auto found = m_WriteTimes.find(path);
+		if (found == m_WriteTimes.end() || found->second != writeTime)
+		{
+			m_WriteTimes[path] = writeTime;
+			changed.push_back(path);
+		}
+	}
+
+	return changed;
+}
+
+#endif
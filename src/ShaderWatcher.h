@@ -0,0 +1,35 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// Vigila un directorio de shaders y devuelve los archivos que se modificaron desde la ltima consulta.
+/// En Linux usa inotify, as que Poll no toca el disco si no pas nada. En otras plataformas compara
+/// las fechas de modificacin de los archivos, como mucho dos veces por segundo.
+/// </summary>
+class ShaderWatcher
+{
+private:
+	std::string m_Directory;
+#ifdef __linux__
+	int m_Descriptor;
+	int m_Watch;
+#else
+	std::unordered_map<std::string, std::filesystem::file_time_type> m_WriteTimes;
+	double m_LastPoll;
+#endif
+public:
+	ShaderWatcher(const std::string& directory);
+	~ShaderWatcher();
+
+	ShaderWatcher(const ShaderWatcher&) = delete;
+	ShaderWatcher& operator=(const ShaderWatcher&) = delete;
+
+	/// <summary>
+	/// Rutas (con el directorio adelante) de los archivos que cambiaron, sin repetir. No bloquea nunca.
+	/// </summary>
+	std::vector<std::string> Poll();
+};
\ No newline at end of file
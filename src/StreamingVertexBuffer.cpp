@@ -0,0 +1,155 @@
+#include "StreamingVertexBuffer.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+StreamingVertexBuffer::StreamingVertexBuffer(unsigned int regionSize, unsigned int regionCount) :
+    m_RegionSize(regionSize),
+    m_RegionCount(regionCount),
+    m_Region(0),
+    m_Cursor(0),
+    m_Persistent(g_GLCaps.BufferStorage),
+    m_MappedData(nullptr),
+    m_Fences(regionCount, nullptr)
+{
+    unsigned int size = regionSize * regionCount;
+    m_Size = size;
+    m_Usage = BufferUsage::Stream;
+
+    if (m_Persistent)
+    {
+        /*
+            Almacenamiento inmutable mapeado para siempre. Con COHERENT lo que escribe la CPU es visible para la GPU
+            sin glFlushMappedBufferRange; los fences se encargan de no pisar datos que la GPU todava no ley.
+        */
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        if (g_GLCaps.DirectStateAccess)
+        {
+            GLCall(glNamedBufferStorage(m_RendererID, size, nullptr, flags));
+            GLCall(m_MappedData = (char*)glMapNamedBufferRange(m_RendererID, 0, size, flags));
+        }
+        else
+        {
+            GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+            GLCall(glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags));
+            GLCall(m_MappedData = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+        }
+    }
+    else
+    {
+        if (g_GLCaps.DirectStateAccess)
+        {
+            GLCall(glNamedBufferData(m_RendererID, size, nullptr, GL_STREAM_DRAW));
+        }
+        else
+        {
+            GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+            GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_STREAM_DRAW));
+        }
+        m_Staging.resize(regionSize);
+    }
+}
+
+StreamingVertexBuffer::~StreamingVertexBuffer()
+{
+    for (GLsync fence : m_Fences)
+    {
+        if (fence)
+        {
+            GLCall(glDeleteSync(fence));
+        }
+    }
+
+    if (m_MappedData)
+    {
+        if (g_GLCaps.DirectStateAccess)
+        {
+            GLCall(glUnmapNamedBuffer(m_RendererID));
+        }
+        else
+        {
+            GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+            GLCall(glUnmapBuffer(GL_ARRAY_BUFFER));
+        }
+    }
+}
+
+void* StreamingVertexBuffer::Map(unsigned int maxSize)
+{
+    ASSERT(maxSize <= m_RegionSize);
+
+    if (m_Cursor + maxSize > m_RegionSize)
+        AdvanceRegion();
+
+    if (!m_Persistent)
+        return m_Staging.data();
+
+    return m_MappedData + m_Region * m_RegionSize + m_Cursor;
+}
+
+unsigned int StreamingVertexBuffer::Commit(unsigned int size)
+{
+    ASSERT(m_Cursor + size <= m_RegionSize);
+
+    unsigned int offset = m_Region * m_RegionSize + m_Cursor;
+    if (!m_Persistent && size)
+    {
+        if (g_GLCaps.DirectStateAccess)
+        {
+            GLCall(glNamedBufferSubData(m_RendererID, offset, size, m_Staging.data()));
+        }
+        else
+        {
+            GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+            GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, m_Staging.data()));
+        }
+    }
+
+    m_Cursor += size;
+    m_Stats.BytesWritten += size;
+    return offset;
+}
+
+void StreamingVertexBuffer::NextRegion()
+{
+    // Una regin que no se lleg a usar no necesita fence: se sigue escribiendo en ella
+    if (m_Cursor == 0)
+        return;
+
+    AdvanceRegion();
+}
+
+void StreamingVertexBuffer::AdvanceRegion()
+{
+    GLsync& fence = m_Fences[m_Region];
+    if (fence)
+    {
+        GLCall(glDeleteSync(fence));
+    }
+    GLCall(fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    m_Region = (m_Region + 1) % m_RegionCount;
+    m_Cursor = 0;
+    WaitRegion(m_Region);
+}
+
+void StreamingVertexBuffer::WaitRegion(unsigned int region)
+{
+    GLsync& fence = m_Fences[region];
+    if (!fence)
+        return;
+
+    // Primero se pregunta sin esperar; solo si la GPU sigue atrasada se bloquea hasta que termine
+    GLCall(GLenum result = glClientWaitSync(fence, 0, 0));
+    if (result == GL_TIMEOUT_EXPIRED)
+    {
+        m_Stats.Stalls++;
+        while (result == GL_TIMEOUT_EXPIRED)
+        {
+            GLCall(result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+        }
+    }
+
+    GLCall(glDeleteSync(fence));
+    fence = nullptr;
+}
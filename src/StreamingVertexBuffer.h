@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+
+#include "GL/glew.h"
+
+#include "VertexBuffer.h"
+
+/// <summary>
+/// Vertex Buffer para geometra que se regenera en la CPU cada frame (sprites, partculas).
+/// El almacenamiento se divide en varias regiones que se usan por turnos: mientras la GPU dibuja con una,
+/// la CPU escribe en la siguiente. Cada regin queda protegida por un fence hasta que la GPU termina de leerla.
+/// Si hay glBufferStorage, el buffer se mapea una sola vez de forma persistente y coherente, as que escribir
+/// es copiar a memoria y nada ms: no hay map/unmap por frame ni copias del driver.
+/// El almacenamiento es inmutable, as que SetData y Resize de Buffer no se usan con este buffer.
+/// </summary>
+class StreamingVertexBuffer : public VertexBuffer
+{
+public:
+	static const unsigned int DefaultRegionCount = 3;
+
+	struct Stats
+	{
+		// Veces que hubo que esperar a la GPU para reutilizar una regin
+		unsigned int Stalls = 0;
+		unsigned int BytesWritten = 0;
+	};
+
+	/// <param name="regionSize">Bytes de cada regin. Conviene que sea mltiplo del tamao del vrtice</param>
+	/// <param name="regionCount">Cantidad de regiones. Con 3 la CPU puede ir hasta dos frames adelantada</param>
+	StreamingVertexBuffer(unsigned int regionSize, unsigned int regionCount = DefaultRegionCount);
+	~StreamingVertexBuffer();
+
+	/// <summary>
+	/// Devuelve dnde escribir hasta "maxSize" bytes. Si no entran en lo que queda de la regin actual,
+	/// se pasa a la siguiente (esperando a la GPU si todava la est usando).
+	/// El puntero deja de valer despus de NextRegion o de otro Map que cambie de regin.
+	/// </summary>
+	void* Map(unsigned int maxSize);
+
+	/// <summary>
+	/// Confirma los "size" bytes escritos desde el ltimo Map
+	/// </summary>
+	/// <returns>Offset en bytes de esos datos dentro del buffer, para usarlo como base en el draw</returns>
+	unsigned int Commit(unsigned int size);
+
+	/// <summary>
+	/// Protege la regin actual con un fence y pasa a la siguiente. Se llama una vez por frame,
+	/// despus de los draws que leen lo que se escribi.
+	/// </summary>
+	void NextRegion();
+
+	inline bool IsPersistent() const { return m_Persistent; }
+	inline unsigned int GetRegionSize() const { return m_RegionSize; }
+	// Bytes que todava entran en la regin actual sin cambiar de regin
+	inline unsigned int GetAvailable() const { return m_RegionSize - m_Cursor; }
+	inline const Stats& GetStats() const { return m_Stats; }
+	inline void ResetStats() { m_Stats = Stats(); }
+
+private:
+	void AdvanceRegion();
+	void WaitRegion(unsigned int region);
+
+	unsigned int m_RegionSize;
+	unsigned int m_RegionCount;
+	unsigned int m_Region;
+	// Bytes ya confirmados en la regin actual
+	unsigned int m_Cursor;
+
+	bool m_Persistent;
+	char* m_MappedData;
+	// Sin glBufferStorage se escribe ac y Commit lo sube con glBufferSubData
+	std::vector<char> m_Staging;
+
+	std::vector<GLsync> m_Fences;
+	Stats m_Stats;
+};
\ No newline at end of file
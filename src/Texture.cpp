@@ -1,4 +1,6 @@
 #include "Texture.h"
+#include "GLStateCache.h"
+#include "Profiler.h"
 
 #include "stb_image/stb_image.h"
 
@@ -14,42 +16,79 @@ Texture::Texture(const std::string& path) :
 	stbi_set_flip_vertically_on_load(1);
 	m_LocalBuffer = stbi_load(path.c_str(), &m_Height, &m_Width, &m_BPP, 4);
 
+	Create(m_LocalBuffer);
+
+	if (m_LocalBuffer)
+	{
+		stbi_image_free(m_LocalBuffer);
+	}
+	else
+	{
+		DEBUG_BREAK();
+	}
+}
+
+Texture::Texture(int width, int height, const void* data) :
+	m_RendererID(0),
+	m_LocalBuffer(nullptr),
+	m_Width(width),
+	m_Height(height),
+	m_BPP(4)
+{
+	Create(data);
+}
+
+void Texture::Create(const void* data)
+{
+	if (g_GLCaps.DirectStateAccess)
+	{
+		// Todo por nombre: crear la textura no cambia la que est enlazada en ninguna unidad
+		GLCall(glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID));
+
+		// Para que se reacomoden los pxeles cuando se cambia el tamao de la textura
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+
+		// S y T es como los ejes X e Y pero para las texturas
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+		GLCall(glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+		// Almacenamiento inmutable de un solo nivel; despus solo se suben los pxeles
+		PROFILE_SCOPE("Texture upload");
+		PROFILE_GPU_SCOPE("Texture upload");
+		GLCall(glTextureStorage2D(m_RendererID, 1, GL_RGBA8, m_Width, m_Height));
+		GLCall(glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, data));
+		return;
+	}
+
 	GLCall(glGenTextures(1, &m_RendererID));
-	GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, m_RendererID);
 
-	// Para que se reacomoden los pxeles cuando se cambia el tamao de la textura
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
-
-	// S y T es como los ejes X e Y pero para las texturas
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
 	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
 
-	GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, m_LocalBuffer));
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
-
-	if (m_LocalBuffer)
-	{
-		stbi_image_free(m_LocalBuffer);
-	}
-	else
 	{
-		__debugbreak();
+		PROFILE_SCOPE("Texture upload");
+		PROFILE_GPU_SCOPE("Texture upload");
+		GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_Width, m_Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data));
 	}
+	GLStateCache::BindTexture(0, GL_TEXTURE_2D, 0);
 }
 
 Texture::~Texture()
 {
 	GLCall(glDeleteTextures(1, &m_RendererID));
+	GLStateCache::OnTextureDeleted(m_RendererID);
 }
 
 void Texture::Bind(unsigned int slot /*= 0*/) const
 {
-	GLCall(glActiveTexture(GL_TEXTURE0 + slot));
-	GLCall(glBindTexture(GL_TEXTURE_2D, m_RendererID));
+	GLStateCache::BindTexture(slot, GL_TEXTURE_2D, m_RendererID);
 }
 
-void Texture::Unbind() const
+void Texture::Unbind(unsigned int slot /*= 0*/) const
 {
-	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+	GLStateCache::BindTexture(slot, GL_TEXTURE_2D, 0);
 }
@@ -10,13 +10,20 @@ private:
 	unsigned char* m_LocalBuffer;
 	int m_Width, m_Height, m_BPP;
 
+	// Crea el objeto de OpenGL con los parmetros de siempre y sube "data" (RGBA8 de m_Width x m_Height)
+	void Create(const void* data);
+
 public:
 	Texture(const std::string& path);
+
+	// Crea una textura RGBA8 a partir de pxeles ya cargados en memoria
+	Texture(int width, int height, const void* data);
 	~Texture();
 
 	void Bind(unsigned int slot = 0) const;
-	void Unbind() const;
+	void Unbind(unsigned int slot = 0) const;
 
+	inline unsigned int GetRendererID() const { return m_RendererID; }
 	inline int GetWidth() const { return m_Width; }
 	inline int GetHeight() const { return m_Height; }
 };
\ No newline at end of file
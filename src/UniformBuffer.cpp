@@ -0,0 +1,65 @@
+#include "UniformBuffer.h"
+
+#include "Renderer.h"
+#include "GLStateCache.h"
+
+UniformBuffer::UniformBuffer(unsigned int size)
+    : m_Size(size)
+{
+    if (g_GLCaps.DirectStateAccess)
+    {
+        GLCall(glCreateBuffers(1, &m_RendererID));
+        GLCall(glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW));
+    }
+    else
+    {
+        GLCall(glGenBuffers(1, &m_RendererID));
+        GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+        GLCall(glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+    }
+}
+
+UniformBuffer::~UniformBuffer()
+{
+    GLCall(glDeleteBuffers(1, &m_RendererID));
+    GLStateCache::OnBufferDeleted(m_RendererID);
+}
+
+void UniformBuffer::SetData(const void* data, unsigned int size, unsigned int offset)
+{
+    ASSERT(offset + size <= m_Size);
+
+    if (g_GLCaps.DirectStateAccess)
+    {
+        GLCall(glNamedBufferSubData(m_RendererID, offset, size, data));
+    }
+    else
+    {
+        GLStateCache::BindBuffer(GL_UNIFORM_BUFFER, m_RendererID);
+        GLCall(glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data));
+    }
+}
+
+void UniformBuffer::BindBase(unsigned int binding) const
+{
+    GLCall(glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID));
+}
+
+void UniformBuffer::BindRange(unsigned int binding, unsigned int offset, unsigned int size) const
+{
+    GLCall(glBindBufferRange(GL_UNIFORM_BUFFER, binding, m_RendererID, offset, size));
+}
+
+unsigned int UniformBuffer::GetOffsetAlignment()
+{
+    // No cambia durante la vida del contexto, as que se consulta una sola vez
+    static int alignment = 0;
+    if (alignment == 0)
+    {
+        GLCall(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment));
+        // 256 es el mximo que permite la especificacin, as que sirve si el driver no informa nada til
+        if (alignment <= 0)
+            alignment = 256;
+    }
+    return (unsigned int)alignment;
+}
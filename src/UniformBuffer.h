@@ -0,0 +1,35 @@
+#pragma once
+
+/// <summary>
+/// Buffer de uniforms (UBO). Los datos tienen que respetar el layout std140 del bloque en el shader:
+/// con structs de mat4 y vec4 de glm alcanza, pero un vec3 ocupa lo mismo que un vec4.
+/// </summary>
+class UniformBuffer
+{
+private:
+	unsigned int m_RendererID;
+	unsigned int m_Size;
+
+public:
+	/*
+		Puntos de enlace fijos. Shader enlaza los bloques con estos nombres a estos puntos al crear el programa,
+		as todos los programas leen del mismo buffer sin que cada uno tenga su copia.
+	*/
+	static const unsigned int CameraBinding = 0;
+	static const unsigned int ObjectBinding = 1;
+
+	UniformBuffer(unsigned int size);
+	~UniformBuffer();
+
+	void SetData(const void* data, unsigned int size, unsigned int offset = 0);
+
+	// Enlaza el buffer entero al punto "binding"
+	void BindBase(unsigned int binding) const;
+	// Enlaza solo "size" bytes a partir de "offset". El offset tiene que ser mltiplo de GetOffsetAlignment
+	void BindRange(unsigned int binding, unsigned int offset, unsigned int size) const;
+
+	inline unsigned int GetSize() const { return m_Size; }
+
+	// GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT del driver
+	static unsigned int GetOffsetAlignment();
+};
\ No newline at end of file
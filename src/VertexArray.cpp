@@ -1,30 +1,104 @@
 #include "VertexArray.h"
 #include "VertexBufferLayout.h"
 
+#include <iostream>
+
 #include "Renderer.h"
+#include "GLStateCache.h"
 
 VertexArray::VertexArray()
 {
-	GLCall(glGenVertexArrays(1, &m_RendererID));
+	// glCreateVertexArrays deja el objeto ya creado, as que se puede configurar por nombre sin enlazarlo nunca
+	if (g_GLCaps.DirectStateAccess)
+	{
+		GLCall(glCreateVertexArrays(1, &m_RendererID));
+	}
+	else
+	{
+		GLCall(glGenVertexArrays(1, &m_RendererID));
+	}
 }
 
 VertexArray::~VertexArray()
 {
 	GLCall(glDeleteVertexArrays(1, &m_RendererID));
+	GLStateCache::OnVertexArrayDeleted(m_RendererID);
 }
 
 void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout)
+{
+	const auto& elements = layout.GetElements();
+	AddBuffer(vb, elements.data(), (unsigned int)elements.size(), layout.GetStride());
+}
+
+void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferElement* elements, unsigned int count, unsigned int stride)
+{
+	unsigned int binding = (unsigned int)m_Bindings.size();
+	unsigned int first = (unsigned int)m_Attributes.size();
+
+	// El divisor es del punto de enlace, no de cada atributo: todos los elementos de un buffer avanzan igual
+	unsigned int divisor = count ? elements[0].divisor : 0;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		ASSERT(elements[i].divisor == divisor);
+		m_Attributes.push_back({ elements[i].count, elements[i].type, elements[i].normalized, elements[i].offset, binding });
+	}
+	m_Bindings.push_back({ stride, divisor });
+
+	if (!g_GLCaps.DirectStateAccess)
+	{
+		SpecifyAttributes(binding, vb);
+		return;
+	}
+
+	// Con DSA el formato queda separado del buffer: se describe una vez por atributo y despus el buffer
+	// se conecta al punto de enlace por nombre, sin tocar el VAO ni el GL_ARRAY_BUFFER enlazados
+	for (unsigned int index = first; index < (unsigned int)m_Attributes.size(); index++)
+	{
+		const AttributeFormat& attribute = m_Attributes[index];
+		GLCall(glEnableVertexArrayAttrib(m_RendererID, index));
+		GLCall(glVertexArrayAttribFormat(m_RendererID, index, attribute.Count, attribute.Type, attribute.Normalized, attribute.Offset));
+		GLCall(glVertexArrayAttribBinding(m_RendererID, index, binding));
+	}
+
+	if (divisor)
+	{
+		GLCall(glVertexArrayBindingDivisor(m_RendererID, binding, divisor));
+	}
+
+	// Si el buffer es una vista sobre un BufferArena, sus vrtices empiezan ms adelante en el objeto de OpenGL
+	GLCall(glVertexArrayVertexBuffer(m_RendererID, binding, vb.GetRendererID(), vb.GetOffset(), stride));
+}
+
+void VertexArray::SetBuffer(unsigned int binding, const VertexBuffer& vb, unsigned int offset)
+{
+	ASSERT(binding < m_Bindings.size());
+
+	if (g_GLCaps.DirectStateAccess)
+	{
+		GLCall(glVertexArrayVertexBuffer(m_RendererID, binding, vb.GetRendererID(), vb.GetOffset() + offset, m_Bindings[binding].Stride));
+	}
+	else
+	{
+		SpecifyAttributes(binding, vb, offset);
+	}
+}
+
+void VertexArray::SpecifyAttributes(unsigned int binding, const VertexBuffer& vb, unsigned int offset)
 {
 	Bind();
 	vb.Bind();
 
-	// Set up the layout for the buffer
-	const auto& elements = layout.GetElements();
-	unsigned int offset = 0;
-	for (unsigned int i = 0; i < elements.size(); i++)
+	// Si el buffer es una vista sobre un BufferArena, sus vrtices empiezan ms adelante en el objeto de OpenGL
+	unsigned int base = vb.GetOffset() + offset;
+	const BufferBinding& buffer = m_Bindings[binding];
+	for (unsigned int index = 0; index < (unsigned int)m_Attributes.size(); index++)
 	{
-		const auto& element = elements[i];
-		GLCall(glEnableVertexAttribArray(i));
+		const AttributeFormat& attribute = m_Attributes[index];
+		if (attribute.Binding != binding)
+			continue;
+
+		GLCall(glEnableVertexAttribArray(index));
 
         /*
             Describir los atributos en orden de glVertexAttribPointer:
@@ -62,25 +136,107 @@ void VertexArray::AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& la
         */
 		GLCall(
 			glVertexAttribPointer(
-				i,
-				element.count,
-				element.type,
-				element.normalized,
-				layout.GetStride(),
-				(const void*)offset
+				index,
+				attribute.Count,
+				attribute.Type,
+				attribute.Normalized,
+				buffer.Stride,
+				(const void*)(uintptr_t)(base + attribute.Offset)
 			)
 		);
 
-		offset += element.count * VertexBufferElement::GetSizeOfType(element.type);
+		// Con divisor distinto de 0 el atributo avanza una vez cada "divisor" instancias en lugar de por vrtice
+		if (buffer.Divisor)
+		{
+			GLCall(glVertexAttribDivisor(index, buffer.Divisor));
+		}
+	}
+}
+
+// Componentes por columna, cantidad de columnas (ubicaciones que ocupa) y si el atributo GLSL es entero
+static bool GetAttributeShape(unsigned int type, unsigned int& components, unsigned int& columns, bool& integer)
+{
+	integer = false;
+	columns = 1;
+	switch (type)
+	{
+		case GL_FLOAT:				components = 1; return true;
+		case GL_FLOAT_VEC2:			components = 2; return true;
+		case GL_FLOAT_VEC3:			components = 3; return true;
+		case GL_FLOAT_VEC4:			components = 4; return true;
+		case GL_FLOAT_MAT2:			components = 2; columns = 2; return true;
+		case GL_FLOAT_MAT3:			components = 3; columns = 3; return true;
+		case GL_FLOAT_MAT4:			components = 4; columns = 4; return true;
+	}
+
+	integer = true;
+	switch (type)
+	{
+		case GL_INT:
+		case GL_UNSIGNED_INT:		components = 1; return true;
+		case GL_INT_VEC2:
+		case GL_UNSIGNED_INT_VEC2:	components = 2; return true;
+		case GL_INT_VEC3:
+		case GL_UNSIGNED_INT_VEC3:	components = 3; return true;
+		case GL_INT_VEC4:
+		case GL_UNSIGNED_INT_VEC4:	components = 4; return true;
+	}
+
+	return false;
+}
+
+void VertexArray::Validate(const Shader& shader) const
+{
+	unsigned int program = shader.GetRendererID();
+	for (unsigned int validated : m_ValidatedPrograms)
+	{
+		if (validated == program)
+			return;
 	}
+	m_ValidatedPrograms.push_back(program);
+
+	bool valid = true;
+	for (const ShaderResource& attribute : shader.GetResources())
+	{
+		if (attribute.Kind != ShaderResourceKind::Attribute || attribute.Location < 0)
+			continue;
+
+		unsigned int components, columns;
+		bool integer;
+		if (!GetAttributeShape(attribute.Type, components, columns, integer))
+			continue;
+
+		for (unsigned int column = 0; column < columns * attribute.Size; column++)
+		{
+			unsigned int index = attribute.Location + column;
+			const char* problem = nullptr;
+			if (index >= m_Attributes.size())
+				problem = "is not enabled in the vertex array";
+			// Los componentes que faltan se completan con (0, 0, 0, 1), pero los que sobran se pierden sin aviso
+			else if (m_Attributes[index].Count > components)
+				problem = "has more components in the buffer than the shader reads";
+			// glVertexAttribPointer siempre entrega floats; un ivec/uvec necesitara glVertexAttribIPointer
+			else if (integer)
+				problem = "is an integer input fed through glVertexAttribPointer";
+
+			if (problem)
+			{
+				std::cout << "VertexArray " << m_RendererID << ": attribute '" << attribute.Name << "' of '" << shader.GetFilePath()
+					<< "' (location " << index << ") " << problem << std::endl;
+				valid = false;
+			}
+		}
+	}
+
+	ASSERT(valid);
 }
 
 void VertexArray::Bind() const
 {
-	GLCall(glBindVertexArray(m_RendererID));
+	GLStateCache::BindVertexArray(m_RendererID);
 }
 
 void VertexArray::Unbind() const
 {
-	GLCall(glBindVertexArray(0));
+	GLStateCache::BindVertexArray(0);
 }
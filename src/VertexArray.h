@@ -1,20 +1,91 @@
 #pragma once
 
+#include <array>
+#include <vector>
+
 #include "VertexBuffer.h"
 
 class VertexBufferLayout;
+struct VertexBufferElement;
+class Shader;
 
 class VertexArray
 {
 private:
 	unsigned int m_RendererID;
 
+	struct AttributeFormat
+	{
+		unsigned int Count;
+		unsigned int Type;
+		bool Normalized;
+		// Offset del atributo dentro del vrtice, sin contar el offset del buffer
+		unsigned int Offset;
+		// Punto de enlace (el AddBuffer que lo agreg) del que lee el atributo
+		unsigned int Binding;
+	};
+
+	struct BufferBinding
+	{
+		unsigned int Stride;
+		unsigned int Divisor;
+	};
+
+	// Formato de cada atributo habilitado; la posicin en el vector es el ndice del atributo.
+	// Cada AddBuffer sigue a partir de los atributos del buffer anterior
+	std::vector<AttributeFormat> m_Attributes;
+
+	// Un punto de enlace por cada AddBuffer, en orden
+	std::vector<BufferBinding> m_Bindings;
+
+	// Programas contra los que ya se comprob el formato, para hacerlo una sola vez por par VAO-programa
+	mutable std::vector<unsigned int> m_ValidatedPrograms;
+
 public:
 	VertexArray();
 	~VertexArray();
 
+	/// <summary>
+	/// Asocia un buffer al VAO. Se puede llamar varias veces (por ejemplo, un buffer por vrtice y otro
+	/// por instancia): los atributos de cada buffer ocupan los ndices siguientes a los del anterior.
+	/// </summary>
 	void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
 
+	/// <summary>
+	/// Igual que la anterior, con un layout fijo como el de VertexLayout: los elementos van en un arreglo
+	/// sin memoria dinmica y el stride ya viene calculado.
+	/// </summary>
+	template<size_t N>
+	void AddBuffer(const VertexBuffer& vb, const std::array<VertexBufferElement, N>& elements, unsigned int stride)
+	{
+		AddBuffer(vb, elements.data(), (unsigned int)N, stride);
+	}
+
+	void AddBuffer(const VertexBuffer& vb, const VertexBufferElement* elements, unsigned int count, unsigned int stride);
+
+	/// <summary>
+	/// Cambia el buffer del punto de enlace "binding" (el n-simo AddBuffer) por otro con el mismo layout.
+	/// "offset" son bytes que se saltean al principio del buffer; por ejemplo, para que la instancia 0 lea
+	/// los datos de otra instancia. Con DSA es una sola llamada y no enlaza nada; sin DSA vuelve a especificar
+	/// los atributos de ese buffer. No usarla sobre un VAO que entreg VertexArrayCache, porque otros lo comparten.
+	/// </summary>
+	void SetBuffer(unsigned int binding, const VertexBuffer& vb, unsigned int offset = 0);
+
+	/// <summary>
+	/// Comprueba que los atributos que lee "shader" estn habilitados en el VAO con un formato compatible.
+	/// Solo hace el trabajo la primera vez que se usa cada programa; si algo no coincide, informa cul
+	/// atributo y corta con ASSERT en lugar de dibujar basura.
+	/// </summary>
+	void Validate(const Shader& shader) const;
+
 	void Bind() const;
 	void Unbind() const;
+
+	inline unsigned int GetRendererID() const { return m_RendererID; }
+	inline unsigned int GetBindingCount() const { return (unsigned int)m_Bindings.size(); }
+	inline unsigned int GetBindingStride(unsigned int binding) const { return m_Bindings[binding].Stride; }
+
+private:
+	// Camino sin DSA: enlaza el VAO y el buffer y especifica con glVertexAttribPointer los atributos de "binding"
+	void SpecifyAttributes(unsigned int binding, const VertexBuffer& vb, unsigned int offset = 0);
 };
\ No newline at end of file
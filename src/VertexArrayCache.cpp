@@ -0,0 +1,118 @@
+#include "VertexArrayCache.h"
+#include "VertexBufferLayout.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct CacheEntry
+{
+	uint64_t Hash;
+	// La clave completa, para no confundir dos configuraciones con el mismo hash
+	std::vector<uint32_t> Key;
+	std::vector<unsigned int> Buffers;
+	std::unique_ptr<VertexArray> Instance;
+};
+
+// Ordenadas por Hash
+static std::vector<CacheEntry> s_Entries;
+static VertexArrayCache::Stats s_Stats;
+
+// Se reusa entre llamadas para que un acierto no reserve memoria
+static std::vector<uint32_t> s_Key;
+
+VertexArraySource::VertexArraySource(const VertexBuffer& vb, const VertexBufferLayout& layout)
+	: Buffer(&vb), Elements(layout.GetElements().data()), Count((unsigned int)layout.GetElements().size()), Stride(layout.GetStride())
+{
+}
+
+static uint64_t HashWords(const std::vector<uint32_t>& words)
+{
+	// FNV-1a de 64 bits sobre los bytes de cada palabra
+	uint64_t hash = 14695981039346656037ull;
+	for (uint32_t word : words)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			hash ^= (word >> (i * 8)) & 0xFF;
+			hash *= 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+VertexArray& VertexArrayCache::Get(const VertexBuffer& vb, const VertexBufferLayout& layout)
+{
+	return Get({ VertexArraySource(vb, layout) });
+}
+
+VertexArray& VertexArrayCache::Get(std::initializer_list<VertexArraySource> sources)
+{
+	s_Key.clear();
+	for (const VertexArraySource& source : sources)
+	{
+		s_Key.push_back(source.Buffer->GetRendererID());
+		s_Key.push_back(source.Buffer->GetOffset());
+		s_Key.push_back(source.Stride);
+		s_Key.push_back(source.Count);
+		for (unsigned int i = 0; i < source.Count; i++)
+		{
+			const VertexBufferElement& element = source.Elements[i];
+			s_Key.push_back(element.type);
+			s_Key.push_back(element.count);
+			s_Key.push_back(element.normalized);
+			s_Key.push_back(element.divisor);
+			s_Key.push_back(element.offset);
+		}
+	}
+
+	uint64_t hash = HashWords(s_Key);
+	auto it = std::lower_bound(s_Entries.begin(), s_Entries.end(), hash, [](const CacheEntry& entry, uint64_t hash) { return entry.Hash < hash; });
+	for (auto match = it; match != s_Entries.end() && match->Hash == hash; ++match)
+	{
+		if (match->Key == s_Key)
+		{
+			s_Stats.Hits++;
+			return *match->Instance;
+		}
+	}
+
+	s_Stats.Misses++;
+	CacheEntry entry;
+	entry.Hash = hash;
+	entry.Key = s_Key;
+	entry.Instance = std::make_unique<VertexArray>();
+	for (const VertexArraySource& source : sources)
+	{
+		entry.Buffers.push_back(source.Buffer->GetRendererID());
+		entry.Instance->AddBuffer(*source.Buffer, source.Elements, source.Count, source.Stride);
+	}
+
+	VertexArray& vertexArray = *entry.Instance;
+	s_Entries.insert(it, std::move(entry));
+	s_Stats.VertexArrays = (unsigned int)s_Entries.size();
+	return vertexArray;
+}
+
+void VertexArrayCache::OnBufferDeleted(unsigned int buffer)
+{
+	// El VAO se queda con el objeto borrado aunque el id se libere, as que hay que descartarlo
+	// antes de que un buffer nuevo con el mismo id encuentre esta entrada
+	s_Entries.erase(std::remove_if(s_Entries.begin(), s_Entries.end(), [buffer](const CacheEntry& entry)
+	{
+		return std::find(entry.Buffers.begin(), entry.Buffers.end(), buffer) != entry.Buffers.end();
+	}), s_Entries.end());
+	s_Stats.VertexArrays = (unsigned int)s_Entries.size();
+}
+
+const VertexArrayCache::Stats& VertexArrayCache::GetStats()
+{
+	return s_Stats;
+}
+
+void VertexArrayCache::Shutdown()
+{
+	s_Entries.clear();
+	s_Stats.VertexArrays = 0;
+}
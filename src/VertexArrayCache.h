@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <initializer_list>
+
+#include "VertexArray.h"
+
+class VertexBufferLayout;
+struct VertexBufferElement;
+
+/// <summary>
+/// Un buffer con su layout, tal como se pasara a VertexArray::AddBuffer
+/// </summary>
+struct VertexArraySource
+{
+	const VertexBuffer* Buffer;
+	const VertexBufferElement* Elements;
+	unsigned int Count;
+	unsigned int Stride;
+
+	VertexArraySource(const VertexBuffer& vb, const VertexBufferLayout& layout);
+
+	template<size_t N>
+	VertexArraySource(const VertexBuffer& vb, const std::array<VertexBufferElement, N>& elements, unsigned int stride)
+		: Buffer(&vb), Elements(elements.data()), Count((unsigned int)N), Stride(stride)
+	{
+	}
+};
+
+/// <summary>
+/// VAOs compartidos entre todos los que usan la misma configuracin. La clave es un hash FNV-1a de los
+/// buffers (id, offset y stride) y del formato de cada atributo, as que dos objetos que dibujan el mismo
+/// buffer con el mismo layout reciben el mismo VAO en lugar de crear uno cada uno. Los VAOs viven hasta
+/// que se borra alguno de sus buffers o hasta Shutdown; no hay que modificarlos con AddBuffer ni SetBuffer.
+/// </summary>
+class VertexArrayCache
+{
+public:
+	struct Stats
+	{
+		// Pedidos que encontraron un VAO con la misma configuracin
+		unsigned int Hits = 0;
+		// Pedidos que tuvieron que crear uno
+		unsigned int Misses = 0;
+		// VAOs vivos en la cach
+		unsigned int VertexArrays = 0;
+	};
+
+	static VertexArray& Get(const VertexBuffer& vb, const VertexBufferLayout& layout);
+
+	template<size_t N>
+	static VertexArray& Get(const VertexBuffer& vb, const std::array<VertexBufferElement, N>& elements, unsigned int stride)
+	{
+		return Get({ VertexArraySource(vb, elements, stride) });
+	}
+
+	/// <summary>
+	/// Varios buffers en un mismo VAO (por ejemplo, uno por vrtice y otro por instancia), cada uno en el
+	/// punto de enlace de su posicin en la lista.
+	/// </summary>
+	static VertexArray& Get(std::initializer_list<VertexArraySource> sources);
+
+	// Saca de la cach los VAOs que leen de "buffer"; la llaman Buffer y BufferArena al borrar el objeto de OpenGL
+	static void OnBufferDeleted(unsigned int buffer);
+
+	static const Stats& GetStats();
+
+	// Borra todos los VAOs. Se llama antes de destruir el contexto
+	static void Shutdown();
+};
\ No newline at end of file
@@ -1,26 +1,37 @@
 #include "VertexBuffer.h"
 
 #include "Renderer.h"
+#include "GLStateCache.h"
 
-VertexBuffer::VertexBuffer(const void* data, unsigned int size)
+VertexBuffer::VertexBuffer()
+    : Buffer(GL_ARRAY_BUFFER)
 {
-    /* Creo un buffer para almacenar vrtices */
-    GLCall(glGenBuffers(1, &m_RendererID));
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
-    GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
 }
 
-VertexBuffer::~VertexBuffer()
+/* Creo un buffer para almacenar vrtices */
+VertexBuffer::VertexBuffer(const void* data, unsigned int size, BufferUsage usage)
+    : Buffer(GL_ARRAY_BUFFER, data, size, usage)
 {
-    GLCall(glDeleteBuffers(1, &m_RendererID));
+}
+
+/* Sin datos iniciales: el contenido se sube despus con SetData */
+VertexBuffer::VertexBuffer(unsigned int size, BufferUsage usage)
+    : Buffer(GL_ARRAY_BUFFER, nullptr, size, usage)
+{
+}
+
+VertexBuffer::VertexBuffer(BufferArena& arena, const void* data, unsigned int size)
+    : Buffer(GL_ARRAY_BUFFER, &arena, BufferUsage::Static)
+{
+    Allocate(data, size);
 }
 
 void VertexBuffer::Bind() const
 {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_RendererID));
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, m_RendererID);
 }
 
 void VertexBuffer::Unbind() const
 {
-    GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GLStateCache::BindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -1,14 +1,21 @@
 #pragma once
 
-class VertexBuffer
+#include "Buffer.h"
+
+class VertexBuffer : public Buffer
 {
-private:
-	// Identificador para todo tipo de objeto de OpenGL que asignamos a memoria
-	unsigned int m_RendererID;
+protected:
+	// Solo crea el objeto de OpenGL, sin reservar memoria. Lo usan los buffers que administran su propio almacenamiento
+	VertexBuffer();
 
 public:
-	VertexBuffer(const void* data, unsigned int size);
-	~VertexBuffer();
+	VertexBuffer(const void* data, unsigned int size, BufferUsage usage = BufferUsage::Static);
+
+	// Crea un buffer vaco de "size" bytes pensado para ser reescrito con SetData
+	VertexBuffer(unsigned int size, BufferUsage usage = BufferUsage::Dynamic);
+
+	// Vista de "size" bytes dentro de "arena". VertexArray::AddBuffer ya tiene en cuenta el offset
+	VertexBuffer(BufferArena& arena, const void* data, unsigned int size);
 
 	void Bind() const;
 	void Unbind() const;
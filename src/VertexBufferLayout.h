@@ -1,29 +1,109 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 #include <GL/glew.h>
 #include <assert.h>
 #include "Renderer.h"
 
+#include "glm/gtc/packing.hpp"
+
+/*
+	Tipos de componente que no existen en C++. Solo guardan los bits tal como los lee OpenGL;
+	se arman con ToHalf y PackSnorm2_10_10_10.
+*/
+
+// Float de 16 bits (GL_HALF_FLOAT)
+struct Half
+{
+	uint16_t Bits;
+};
+
+// x, y, z con 10 bits y w con 2, todos con signo y normalizados (GL_INT_2_10_10_10_REV). Es un atributo de 4 componentes
+struct PackedSnorm2_10_10_10
+{
+	uint32_t Bits;
+};
+
+// Las conversiones son las de glm/packing.hpp, envueltas para que el resultado tenga el tipo que corresponde
+inline Half ToHalf(float value)
+{
+	return { glm::packHalf1x16(value) };
+}
+
+// Cada componente se limita a [-1, 1]
+inline PackedSnorm2_10_10_10 PackSnorm2_10_10_10(const glm::vec4& value)
+{
+	return { glm::packSnorm3x10_1x2(value) };
+}
+
+/// <summary>
+/// Cmo describe OpenGL un tipo de componente. Solo los tipos listados ac se pueden usar en Push y en VertexField;
+/// cualquier otro falla al compilar.
+/// Los enteros chicos se normalizan: un unsigned char de 0 a 255 le llega al shader como un float de 0 a 1,
+/// y un short de -32767 a 32767, como uno de -1 a 1.
+/// </summary>
+template<typename T>
+struct VertexComponentTraits
+{
+	static constexpr bool Supported = false;
+};
+
+template<unsigned int GLType, bool IsNormalized, unsigned int ComponentsPerValue = 1>
+struct VertexComponentTraitsBase
+{
+	static constexpr bool Supported = true;
+	static constexpr unsigned int Type = GLType;
+	static constexpr bool Normalized = IsNormalized;
+	// Componentes del atributo que ocupa un solo valor del tipo (4 en los formatos empaquetados)
+	static constexpr unsigned int Components = ComponentsPerValue;
+};
+
+template<> struct VertexComponentTraits<float>					: VertexComponentTraitsBase<GL_FLOAT, false> {};
+template<> struct VertexComponentTraits<Half>					: VertexComponentTraitsBase<GL_HALF_FLOAT, false> {};
+template<> struct VertexComponentTraits<unsigned int>			: VertexComponentTraitsBase<GL_UNSIGNED_INT, false> {};
+template<> struct VertexComponentTraits<unsigned char>			: VertexComponentTraitsBase<GL_UNSIGNED_BYTE, true> {};
+template<> struct VertexComponentTraits<short>					: VertexComponentTraitsBase<GL_SHORT, true> {};
+template<> struct VertexComponentTraits<unsigned short>			: VertexComponentTraitsBase<GL_UNSIGNED_SHORT, true> {};
+template<> struct VertexComponentTraits<PackedSnorm2_10_10_10>	: VertexComponentTraitsBase<GL_INT_2_10_10_10_REV, true, 4> {};
+
 struct VertexBufferElement
 {
 	unsigned int type;
 	unsigned int count;
 	bool normalized;
+	// Cada cuntas instancias avanza el atributo. 0 significa que avanza por vrtice
+	unsigned int divisor;
+	// Bytes desde el principio del vrtice
+	unsigned int offset;
 
-	static unsigned int GetSizeOfType(unsigned int type)
+	static constexpr unsigned int GetSizeOfType(unsigned int type)
 	{
 		switch (type)
 		{
-			case GL_FLOAT:			return 4;
-			case GL_UNSIGNED_INT:	return 4;
-			case GL_UNSIGNED_BYTE:	return 1;
+			case GL_FLOAT:					return 4;
+			case GL_UNSIGNED_INT:			return 4;
+			case GL_UNSIGNED_BYTE:			return 1;
+			case GL_HALF_FLOAT:				return 2;
+			case GL_SHORT:					return 2;
+			case GL_UNSIGNED_SHORT:			return 2;
+			// Las 4 componentes juntas
+			case GL_INT_2_10_10_10_REV:		return 4;
 		}
-		
+
 		ASSERT(false);
 
 		return 0;
 	}
+
+	// Bytes que ocupan "count" componentes de "type"
+	static constexpr unsigned int GetSize(unsigned int type, unsigned int count)
+	{
+		return type == GL_INT_2_10_10_10_REV ? GetSizeOfType(type) : count * GetSizeOfType(type);
+	}
 };
 
 class VertexBufferLayout
@@ -31,39 +111,112 @@ class VertexBufferLayout
 private:
 	std::vector<VertexBufferElement> m_Elements;
 	unsigned int m_Stride;
-	
+
 public:
 	VertexBufferLayout()
 		: m_Stride(0) {}
 
 	template<typename T>
-	void Push(unsigned int count)
+	void Push(unsigned int count, unsigned int divisor = 0)
 	{
-		// Error cuando el tipo de dato que se usa no corresponde a los listados abajo
-		ASSERT(false);
-	}
+		using Traits = VertexComponentTraits<T>;
+		static_assert(Traits::Supported, "Tipo de componente sin equivalente en OpenGL: ver VertexComponentTraits");
 
-	template<>
-	void Push<float>(unsigned int count)
-	{
-		m_Elements.push_back(VertexBufferElement(GL_FLOAT, count, GL_FALSE));
-		m_Stride += count * VertexBufferElement::GetSizeOfType(GL_FLOAT);
-	}
+		// Los formatos empaquetados ya traen sus 4 componentes en un valor
+		if constexpr (Traits::Components > 1)
+		{
+			ASSERT(count == 1);
+			count = Traits::Components;
+		}
 
-	template<>
-	void Push<unsigned int>(unsigned int count)
-	{
-		m_Elements.push_back(VertexBufferElement(GL_UNSIGNED_INT, count, GL_FALSE));
-		m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_INT);
+		m_Elements.push_back({ Traits::Type, count, Traits::Normalized, divisor, m_Stride });
+		m_Stride += VertexBufferElement::GetSize(Traits::Type, count);
 	}
 
-	template<>
-	void Push<unsigned char>(unsigned int count)
+	inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
+	inline unsigned int GetStride() const { return m_Stride; }
+};
+
+/// <summary>
+/// Qu tipo de componente y cuntas componentes tiene un campo de un vrtice: un escalar, un glm::vec o un arreglo.
+/// </summary>
+template<typename T>
+struct VertexFieldTraits
+{
+	using Component = T;
+	static constexpr unsigned int Count = 1;
+};
+
+template<glm::length_t L, typename T, glm::qualifier Q>
+struct VertexFieldTraits<glm::vec<L, T, Q>>
+{
+	using Component = T;
+	static constexpr unsigned int Count = L;
+};
+
+template<typename T, size_t N>
+struct VertexFieldTraits<T[N]>
+{
+	using Component = T;
+	static constexpr unsigned int Count = N;
+};
+
+/// <summary>
+/// Describe un campo de un struct de vrtice: su tipo y su offset, obtenido con offsetof.
+/// Conviene usarlo a travs de VERTEX_FIELD.
+/// </summary>
+template<typename Vertex, typename Field, size_t Offset>
+struct VertexField
+{
+	using Traits = VertexComponentTraits<typename VertexFieldTraits<Field>::Component>;
+	static_assert(Traits::Supported, "Tipo de componente sin equivalente en OpenGL: ver VertexComponentTraits");
+
+	static constexpr unsigned int Count = VertexFieldTraits<Field>::Count * Traits::Components;
+	static_assert(Count >= 1 && Count <= 4, "Un atributo tiene entre 1 y 4 componentes; las matrices van campo por campo");
+
+	static constexpr VertexBufferElement Element = { Traits::Type, Count, Traits::Normalized, 0, (unsigned int)Offset };
+	static constexpr unsigned int Size = VertexBufferElement::GetSize(Traits::Type, Count);
+	static_assert(Size == sizeof(Field), "El campo no ocupa lo que OpenGL va a leer (glm con alineacin?)");
+};
+
+#define VERTEX_FIELD(Vertex, Member) VertexField<Vertex, decltype(Vertex::Member), offsetof(Vertex, Member)>
+
+// Ningn campo puede salirse del vrtice ni compartir bytes con otro, en cualquier orden que se los liste
+template<size_t N>
+constexpr bool VertexFieldsFit(const std::array<VertexBufferElement, N>& elements, const std::array<unsigned int, N>& sizes, unsigned int stride)
+{
+	for (size_t i = 0; i < N; i++)
 	{
-		m_Elements.push_back(VertexBufferElement(GL_UNSIGNED_BYTE, count, GL_TRUE));
-		m_Stride += count * VertexBufferElement::GetSizeOfType(GL_UNSIGNED_BYTE);
+		if (elements[i].offset + sizes[i] > stride)
+			return false;
+		for (size_t j = i + 1; j < N; j++)
+		{
+			if (elements[i].offset < elements[j].offset + sizes[j] && elements[j].offset < elements[i].offset + sizes[i])
+				return false;
+		}
 	}
+	return true;
+}
 
-	inline const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
-	inline unsigned int GetStride() const { return m_Stride; }
+/// <summary>
+/// Layout de vrtice armado en tiempo de compilacin a partir de un struct. Los campos se listan en el orden de
+/// las ubicaciones de los atributos del shader:
+///
+///		using QuadLayout = VertexLayout<QuadVertex, VERTEX_FIELD(QuadVertex, Position), VERTEX_FIELD(QuadVertex, Color)>;
+///		vao.AddBuffer(vb, QuadLayout::Elements, QuadLayout::Stride);
+///
+/// El stride es sizeof(Vertex) y los offsets salen de offsetof, as que no se pueden desincronizar con el struct.
+/// Si los campos se pisan o se salen del struct, no compila.
+/// </summary>
+template<typename Vertex, typename... Fields>
+struct VertexLayout
+{
+	static_assert(std::is_standard_layout_v<Vertex>, "offsetof solo vale en structs de standard layout");
+	static_assert(sizeof...(Fields) > 0, "Un layout necesita al menos un campo");
+
+	static constexpr unsigned int Stride = (unsigned int)sizeof(Vertex);
+	static constexpr std::array<VertexBufferElement, sizeof...(Fields)> Elements = { Fields::Element... };
+
+	static_assert(VertexFieldsFit(Elements, std::array<unsigned int, sizeof...(Fields)>{ Fields::Size... }, Stride),
+		"Hay campos que se pisan o se salen del vrtice");
 };
\ No newline at end of file
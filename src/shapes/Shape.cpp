@@ -19,3 +19,8 @@ unsigned int Shape::GetVertices() const
 {
     return m_Vertices_Qnty;
 }
+
+bool Shape::HasTexCoords() const
+{
+    return m_HasTexCoords;
+}
@@ -15,11 +15,15 @@ protected:
     // Cantidad total de vrtices que forman a figura
     unsigned int m_Vertices_Qnty;
 
+    // Si cada vrtice de m_Positions trae, despus de x e y, sus coordenadas de textura
+    bool m_HasTexCoords = false;
+
 public:
     float* GetPositions() const;
     unsigned int* GetIndexes() const;
     unsigned int GetTriangles() const;
     unsigned int GetVertices() const;
+    bool HasTexCoords() const;
 
 protected:
     Shape() = default;
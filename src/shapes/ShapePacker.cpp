@@ -0,0 +1,120 @@
+#include "ShapePacker.h"
+
+#include <cstring>
+#include <limits>
+
+#include "Shape.h"
+#include "Shader.h"
+#include "VertexArray.h"
+#include "VertexBufferLayout.h"
+
+using ShapeVertexLayout = VertexLayout<ShapeVertex,
+	VERTEX_FIELD(ShapeVertex, Position),
+	VERTEX_FIELD(ShapeVertex, TexCoord),
+	VERTEX_FIELD(ShapeVertex, Color)>;
+
+using QuantizedShapeVertexLayout = VertexLayout<QuantizedShapeVertex,
+	VERTEX_FIELD(QuantizedShapeVertex, Position),
+	VERTEX_FIELD(QuantizedShapeVertex, TexCoord),
+	VERTEX_FIELD(QuantizedShapeVertex, Color)>;
+
+static_assert(sizeof(QuantizedShapeVertex) == 12, "QuantizedShapeVertex no debera tener relleno");
+
+// Convierte un valor de [-1, 1] o [0, 1] al entero normalizado que OpenGL vuelve a llevar al mismo rango
+template<typename T>
+static T Normalize(float value)
+{
+	constexpr float scale = (float)std::numeric_limits<T>::max();
+	constexpr float lowest = std::numeric_limits<T>::is_signed ? -1.0f : 0.0f;
+	return (T)glm::round(glm::clamp(value, lowest, 1.0f) * scale);
+}
+
+PackedShape ShapePacker::Pack(const Shape& shape, ShapeVertexFormat format, const glm::vec4& color)
+{
+	const float* positions = shape.GetPositions();
+	unsigned int components = shape.HasTexCoords() ? 4 : 2;
+	unsigned int vertexCount = shape.GetVertices();
+
+	glm::vec2 min(std::numeric_limits<float>::max()), max(std::numeric_limits<float>::lowest());
+	for (unsigned int i = 0; i < vertexCount; i++)
+	{
+		glm::vec2 position(positions[i * components], positions[i * components + 1]);
+		min = glm::min(min, position);
+		max = glm::max(max, position);
+	}
+
+	glm::vec2 center = (min + max) * 0.5f;
+	// Una figura sin ancho o sin alto no se puede dividir por su tamao en ese eje
+	glm::vec2 extent = glm::max((max - min) * 0.5f, glm::vec2(1e-6f));
+
+	PackedShape packed;
+	packed.Format = format;
+	packed.VertexCount = vertexCount;
+	packed.Stride = GetVertexSize(format);
+	packed.Vertices.resize(vertexCount * packed.Stride);
+
+	const unsigned int* indices = shape.GetIndexes();
+	packed.Indices.assign(indices, indices + 3 * shape.GetTriangles());
+
+	if (format == ShapeVertexFormat::Quantized)
+		packed.Dequantize = glm::vec4(extent, center);
+
+	for (unsigned int i = 0; i < vertexCount; i++)
+	{
+		glm::vec2 position(positions[i * components], positions[i * components + 1]);
+		glm::vec2 texCoord = shape.HasTexCoords()
+			? glm::vec2(positions[i * components + 2], positions[i * components + 3])
+			: (position - min) / (extent * 2.0f);
+
+		if (format == ShapeVertexFormat::Float)
+		{
+			ShapeVertex vertex = { position, texCoord, color };
+			std::memcpy(&packed.Vertices[i * packed.Stride], &vertex, sizeof(vertex));
+		}
+		else
+		{
+			glm::vec2 relative = (position - center) / extent;
+			QuantizedShapeVertex vertex;
+			vertex.Position = glm::i16vec2(Normalize<short>(relative.x), Normalize<short>(relative.y));
+			vertex.TexCoord = glm::u16vec2(Normalize<unsigned short>(texCoord.x), Normalize<unsigned short>(texCoord.y));
+			vertex.Color = glm::u8vec4(Normalize<unsigned char>(color.r), Normalize<unsigned char>(color.g),
+				Normalize<unsigned char>(color.b), Normalize<unsigned char>(color.a));
+			std::memcpy(&packed.Vertices[i * packed.Stride], &vertex, sizeof(vertex));
+		}
+	}
+
+	return packed;
+}
+
+void ShapePacker::AddBuffer(VertexArray& va, const VertexBuffer& vb, ShapeVertexFormat format)
+{
+	if (format == ShapeVertexFormat::Float)
+		va.AddBuffer(vb, ShapeVertexLayout::Elements, ShapeVertexLayout::Stride);
+	else
+		va.AddBuffer(vb, QuantizedShapeVertexLayout::Elements, QuantizedShapeVertexLayout::Stride);
+}
+
+ShapeShader ShapePacker::ResolveShader(Shader& shader)
+{
+	ShapeShader resolved;
+	resolved.Float = &shader;
+	resolved.Quantized = &shader.GetVariant({ "QUANTIZED" });
+	resolved.Dequantize = resolved.Quantized->GetUniform("u_Dequantize");
+	return resolved;
+}
+
+Shader& ShapePacker::PrepareShader(const ShapeShader& shader, const PackedShape& shape)
+{
+	if (shape.Format == ShapeVertexFormat::Float)
+		return *shader.Float;
+
+	Shader& variant = *shader.Quantized;
+	variant.Bind();
+	variant.SetUniform4f(shader.Dequantize, shape.Dequantize.x, shape.Dequantize.y, shape.Dequantize.z, shape.Dequantize.w);
+	return variant;
+}
+
+unsigned int ShapePacker::GetVertexSize(ShapeVertexFormat format)
+{
+	return format == ShapeVertexFormat::Float ? ShapeVertexLayout::Stride : QuantizedShapeVertexLayout::Stride;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/type_precision.hpp"
+
+#include "Shader.h"
+
+class Shape;
+class VertexArray;
+class VertexBuffer;
+
+/// <summary>
+/// Formato de los vrtices que arma ShapePacker
+/// </summary>
+enum class ShapeVertexFormat
+{
+	// Todo en float: 32 bytes por vrtice
+	Float,
+	// Posicin snorm16 relativa a los lmites de la figura, UV unorm16 y color RGBA8: 12 bytes por vrtice
+	Quantized
+};
+
+struct ShapeVertex
+{
+	glm::vec2 Position;
+	glm::vec2 TexCoord;
+	glm::vec4 Color;
+};
+
+struct QuantizedShapeVertex
+{
+	// De -32767 a 32767 entre el mnimo y el mximo de la figura; el shader lo vuelve a escalar con u_Dequantize
+	glm::i16vec2 Position;
+	glm::u16vec2 TexCoord;
+	glm::u8vec4 Color;
+};
+
+/// <summary>
+/// Vrtices e ndices de una figura ya convertidos a un ShapeVertexFormat, listos para subir a un VertexBuffer
+/// </summary>
+struct PackedShape
+{
+	ShapeVertexFormat Format;
+	std::vector<unsigned char> Vertices;
+	std::vector<unsigned int> Indices;
+	unsigned int VertexCount = 0;
+	unsigned int Stride = 0;
+
+	// Lo que hay que hacer con la posicin guardada para volver a la original: xy escala, zw desplazamiento.
+	// Con Float es (1, 1, 0, 0)
+	glm::vec4 Dequantize = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f);
+};
+
+/// <summary>
+/// Las variantes de un shader de figuras para cada formato y el handle de u_Dequantize, resueltos una sola vez
+/// con ShapePacker::ResolveShader para no buscar claves ni nombres de uniforms en cada frame
+/// </summary>
+struct ShapeShader
+{
+	Shader* Float = nullptr;
+	Shader* Quantized = nullptr;
+	UniformHandle Dequantize;
+};
+
+/// <summary>
+/// Convierte la salida de Shape a formatos de vrtice ms compactos. El layout del VAO y la variante del shader
+/// salen del mismo ShapeVertexFormat, as que siempre coinciden con lo que se empaquet.
+/// El shader tiene que tener la clave QUANTIZED y leer la posicin en la ubicacin 0, las UV en la 1
+/// y el color en la 2 (ver res/shaders/Shape.shader).
+/// </summary>
+class ShapePacker
+{
+public:
+	/// <summary>
+	/// Empaqueta la figura. Si no trae coordenadas de textura, se generan proyectando la posicin sobre sus lmites.
+	/// </summary>
+	/// <param name="color">Color de todos los vrtices</param>
+	static PackedShape Pack(const Shape& shape, ShapeVertexFormat format, const glm::vec4& color = glm::vec4(1.0f));
+
+	// Agrega al VAO los atributos del formato, ledos de "vb"
+	static void AddBuffer(VertexArray& va, const VertexBuffer& vb, ShapeVertexFormat format);
+
+	// Pide la variante QUANTIZED de "shader" y resuelve su u_Dequantize. Se llama al crear el objeto, no en cada frame
+	static ShapeShader ResolveShader(Shader& shader);
+
+	/// <summary>
+	/// Devuelve la variante de "shader" que corresponde al formato de "shape", con u_Dequantize ya cargado.
+	/// u_Dequantize es un uniform comn, as que todo lo que se dibuje antes de volver a llamarla tiene que usar
+	/// la misma figura (por ejemplo, todas las instancias de un DrawInstanced).
+	/// </summary>
+	static Shader& PrepareShader(const ShapeShader& shader, const PackedShape& shape);
+
+	static unsigned int GetVertexSize(ShapeVertexFormat format);
+};
\ No newline at end of file
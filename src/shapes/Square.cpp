@@ -6,6 +6,7 @@ Square::Square(float sideLength, bool hasTexture, bool centered, float x, float
 {
 	m_Triangles_Qnty = 2;
 	m_Vertices_Qnty = 4;
+	m_HasTexCoords = hasTexture;
 	BuildShape();
 }
 
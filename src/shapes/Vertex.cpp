@@ -33,7 +33,7 @@ float Vertex::GetY() const
     return m_Y;
 }
 
-const Vertex& Vertex::GetRotatedVertex(float angle) const
+Vertex Vertex::GetRotatedVertex(float angle) const
 {
     float new_x = m_X * cosf(angle) - m_Y * sinf(angle);
     float new_y = m_X * sinf(angle) + m_Y * cosf(angle);
@@ -14,7 +14,7 @@ public:
 	float GetX() const;
 	float GetY() const;
 
-	const Vertex& GetRotatedVertex(float angle) const;
+	Vertex GetRotatedVertex(float angle) const;
 
 	friend bool operator==(const Vertex& v1, const Vertex& v2);
 	friend bool operator!=(const Vertex& v1, const Vertex& v2);
@@ -0,0 +1,55 @@
+#include "BenchmarkTest.h"
+
+namespace test {
+
+	BenchmarkTest::BenchmarkTest(unsigned int sweepFrames, unsigned int warmupFrames) :
+        m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 0.0f)),
+        m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+        m_SweepFrames(sweepFrames),
+        m_WarmupFrames(warmupFrames),
+        m_AverageTime(0.0),
+        m_SweepStep(-1),
+        m_SweepSteps(0),
+        m_SweepFrame(0),
+        m_SweepSamples(0),
+        m_SweepTime(0.0),
+        m_StepResult(0.0)
+	{
+	}
+
+	void BenchmarkTest::StartSweep(unsigned int steps)
+	{
+        m_SweepStep = steps ? 0 : -1;
+        m_SweepSteps = steps;
+        m_SweepFrame = 0;
+        m_SweepSamples = 0;
+        m_SweepTime = 0.0;
+	}
+
+	bool BenchmarkTest::AddSample(double sample)
+	{
+        if (sample >= 0.0)
+            m_AverageTime += (sample - m_AverageTime) * 0.05;
+
+        if (m_SweepStep < 0)
+            return false;
+
+        if (m_SweepFrame >= m_WarmupFrames && sample >= 0.0)
+        {
+            m_SweepTime += sample;
+            m_SweepSamples++;
+        }
+
+        if (++m_SweepFrame < m_SweepFrames)
+            return false;
+
+        m_StepResult = m_SweepSamples ? m_SweepTime / m_SweepSamples : 0.0;
+        m_SweepFrame = 0;
+        m_SweepSamples = 0;
+        m_SweepTime = 0.0;
+        if ((unsigned int)++m_SweepStep == m_SweepSteps)
+            m_SweepStep = -1;
+        return true;
+	}
+
+}
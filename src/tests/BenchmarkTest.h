@@ -0,0 +1,55 @@
+#pragma once
+#include "Test.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+namespace test {
+
+	/// <summary>
+	/// Base de los tests que miden algo: la cmara ortogrfica de 960x540 que usan todos y un barrido que recorre
+	/// varios pasos de SweepFrames frames, descartando los primeros WarmupFrames de cada uno. Cada frame el test
+	/// le pasa una muestra con AddSample, que tambin lleva el promedio mvil que se muestra fuera del barrido.
+	/// </summary>
+	class BenchmarkTest : public Test
+	{
+	public:
+		BenchmarkTest(unsigned int sweepFrames = 30, unsigned int warmupFrames = 5);
+
+	protected:
+		// Empieza un barrido de "steps" pasos desde el paso 0
+		void StartSweep(unsigned int steps);
+
+		/// <summary>
+		/// Registra la muestra de este frame; una negativa significa que no hubo y no cuenta. Mientras hay un barrido
+		/// tiene que llamarse exactamente una vez por frame, porque tambin es lo que avanza los frames del paso.
+		/// </summary>
+		/// <returns>true si con este frame termin el paso actual; su promedio queda en GetStepResult</returns>
+		bool AddSample(double sample);
+
+		// Paso del barrido en curso, o -1 si no hay ninguno
+		inline int GetSweepStep() const { return m_SweepStep; }
+		// true en el primer frame de cada paso, para que el test cambie lo que mide antes de tomar la muestra
+		inline bool IsStepStart() const { return m_SweepStep >= 0 && m_SweepFrame == 0; }
+		// Promedio del ltimo paso que termin, sin contar el calentamiento. 0 si no tuvo muestras
+		inline double GetStepResult() const { return m_StepResult; }
+		inline double GetAverage() const { return m_AverageTime; }
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+	private:
+		unsigned int m_SweepFrames;
+		unsigned int m_WarmupFrames;
+
+		double m_AverageTime;
+
+		int m_SweepStep;
+		unsigned int m_SweepSteps;
+		unsigned int m_SweepFrame;
+		unsigned int m_SweepSamples;
+		double m_SweepTime;
+		double m_StepResult;
+	};
+
+}
\ No newline at end of file
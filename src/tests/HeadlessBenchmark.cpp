@@ -0,0 +1,56 @@
+#include "HeadlessBenchmark.h"
+
+#include <chrono>
+#include <cstdio>
+
+#include "GLStateCache.h"
+#include "GLMockBackend.h"
+
+namespace test {
+
+	void RunHeadlessBenchmark(const TestMenu& testMenu, unsigned int frames)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		if (frames == 0)
+			frames = 1;
+
+		std::printf("%-20s %12s %14s %14s %14s\n", "Test", "Setup (ms)", "Avg (us/frame)", "Max (us/frame)", "GL calls/frame");
+
+		for (const auto& entry : testMenu.GetTests())
+		{
+			GLStateCache::Invalidate();
+			GLMockBackend::ResetCalls();
+
+			Clock::time_point setupStart = Clock::now();
+			Test* test = entry.second();
+			double setupMs = std::chrono::duration<double, std::milli>(Clock::now() - setupStart).count();
+
+			double totalUs = 0.0;
+			double maxUs = 0.0;
+			unsigned long long totalCalls = 0;
+
+			for (unsigned int frame = 0; frame < frames; frame++)
+			{
+				GLStateCache::NewFrame();
+				GLMockBackend::ResetCalls();
+
+				Clock::time_point frameStart = Clock::now();
+				test->OnUpdate(1.0f / 60.0f);
+				test->OnRender();
+				double frameUs = std::chrono::duration<double, std::micro>(Clock::now() - frameStart).count();
+
+				totalUs += frameUs;
+				if (frameUs > maxUs)
+					maxUs = frameUs;
+				totalCalls += GLMockBackend::GetCalls().size();
+			}
+
+			std::printf("%-20s %12.3f %14.2f %14.2f %14llu\n", entry.first.c_str(), setupMs,
+				totalUs / frames, maxUs, totalCalls / frames);
+
+			delete test;
+		}
+	}
+
+}
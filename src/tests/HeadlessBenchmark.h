@@ -0,0 +1,12 @@
+#pragma once
+#include "Test.h"
+
+namespace test {
+
+	/// <summary>
+	/// Corre cada test registrado en el men durante "frames" frames y muestra por consola el tiempo de CPU
+	/// por frame y la cantidad de llamadas a OpenGL. Pensado para usarse con el backend falso (GLDispatch::UseMock).
+	/// </summary>
+	void RunHeadlessBenchmark(const TestMenu& testMenu, unsigned int frames);
+
+}
\ No newline at end of file
@@ -32,6 +32,8 @@ namespace test {
 			m_Tests.push_back(std::make_pair(name, []() { return new T(); }));
 		}
 
+		inline const std::vector<std::pair<std::string, std::function<Test* ()>>>& GetTests() const { return m_Tests; }
+
 	private:
 		Test*& m_CurrentTest;
 		std::vector<std::pair<std::string, std::function<Test* ()>>> m_Tests;
@@ -0,0 +1,70 @@
+#include "TestBatchRenderer2D.h"
+
+#include "GLStateCache.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+
+	TestBatchRenderer2D::TestBatchRenderer2D() :
+        m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 0.0f)),
+        m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+        m_QuadsPerRow(100),
+        m_QuadsPerColumn(60),
+        m_Textured(true)
+	{
+        GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::SetBlend(true);
+
+        m_BatchRenderer = std::make_unique<BatchRenderer2D>();
+        m_Texture = std::make_unique<Texture>("res/textures/TheCherno.png");
+	}
+
+	TestBatchRenderer2D::~TestBatchRenderer2D()
+	{
+	}
+
+	void TestBatchRenderer2D::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestBatchRenderer2D::OnRender()
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+        m_BatchRenderer->ResetStats();
+        Renderer::BeginScene(m_View, m_Proj);
+        m_BatchRenderer->BeginBatch();
+
+        glm::vec2 size(960.0f / m_QuadsPerRow, 540.0f / m_QuadsPerColumn);
+        for (int y = 0; y < m_QuadsPerColumn; y++)
+        {
+            for (int x = 0; x < m_QuadsPerRow; x++)
+            {
+                glm::vec2 position((x + 0.5f) * size.x, (y + 0.5f) * size.y);
+                glm::vec4 color((float)x / m_QuadsPerRow, 0.3f, (float)y / m_QuadsPerColumn, 1.0f);
+
+                // Se alternan quads planos y texturizados para que ambos caminos compartan el mismo lote
+                if (m_Textured && (x + y) % 2 == 0)
+                    m_BatchRenderer->Submit(position, size * 0.9f, *m_Texture, glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), color);
+                else
+                    m_BatchRenderer->Submit(position, size * 0.9f, color);
+            }
+        }
+
+        m_BatchRenderer->EndBatch();
+	}
+
+	void TestBatchRenderer2D::OnImGuiRender()
+	{
+        ImGui::SliderInt("Quads per row", &m_QuadsPerRow, 1, 400);
+        ImGui::SliderInt("Quads per column", &m_QuadsPerColumn, 1, 300);
+        ImGui::Checkbox("Textured", &m_Textured);
+
+        const BatchRenderer2D::Stats& stats = m_BatchRenderer->GetStats();
+        ImGui::Text("Quads: %u", stats.QuadCount);
+        ImGui::Text("Draw calls: %u", stats.DrawCalls);
+	}
+
+}
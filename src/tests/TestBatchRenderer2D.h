@@ -0,0 +1,35 @@
+#pragma once
+#include "Test.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "Renderer.h"
+#include "Texture.h"
+
+#include <memory>
+
+namespace test {
+
+	class TestBatchRenderer2D : public Test
+	{
+	public:
+		TestBatchRenderer2D();
+		~TestBatchRenderer2D();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		std::unique_ptr<BatchRenderer2D> m_BatchRenderer;
+		std::unique_ptr<Texture> m_Texture;
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		int m_QuadsPerRow;
+		int m_QuadsPerColumn;
+		bool m_Textured;
+	};
+
+}
\ No newline at end of file
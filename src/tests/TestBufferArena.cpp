@@ -0,0 +1,123 @@
+#include "TestBufferArena.h"
+
+#include "GLStateCache.h"
+#include "ShaderLibrary.h"
+
+#include "imgui/imgui.h"
+
+#include "shapes/Square.h"
+#include "shapes/Circle.h"
+
+namespace test {
+
+	// Intercala la posicin de la figura con una coordenada de textura derivada de ella
+	static void BuildShapeData(const Shape& shape, std::vector<float>& vertices, std::vector<unsigned int>& indices)
+	{
+        const float* positions = shape.GetPositions();
+        for (unsigned int i = 0; i < shape.GetVertices(); i++)
+        {
+            float x = positions[2 * i];
+            float y = positions[2 * i + 1];
+            vertices.insert(vertices.end(), { x, y, x + 0.5f, y + 0.5f });
+        }
+
+        const unsigned int* shapeIndices = shape.GetIndexes();
+        indices.assign(shapeIndices, shapeIndices + 3 * shape.GetTriangles());
+	}
+
+	TestBufferArena::TestBufferArena() :
+        m_Random(1234)
+	{
+        m_Arena = std::make_unique<BufferArena>(PageSize, MaxPages);
+
+        BuildShapeData(Square(1.0f), m_Shapes[0].Vertices, m_Shapes[0].Indices);
+        BuildShapeData(Circle(0.5f), m_Shapes[1].Vertices, m_Shapes[1].Indices);
+
+        m_Shader = &ShaderLibrary::Get("res/shaders/Basic.shader");
+        m_Shader->Bind();
+        m_Shader->SetUniform4f("u_Color", 0.3f, 0.7f, 0.9f, 1.0f);
+
+        AddMeshes(200);
+	}
+
+	TestBufferArena::~TestBufferArena()
+	{
+	}
+
+	void TestBufferArena::AddMeshes(unsigned int count)
+	{
+        VertexBufferLayout layout;
+        layout.Push<float>(2);
+        layout.Push<float>(2);
+
+        std::uniform_real_distribution<float> x(0.0f, 960.0f), y(0.0f, 540.0f), size(8.0f, 40.0f);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            const ShapeData& shape = m_Shapes[m_Random() % 2];
+            unsigned int vertexSize = (unsigned int)(shape.Vertices.size() * sizeof(float));
+
+            Mesh mesh;
+            mesh.VB = std::make_unique<VertexBuffer>(*m_Arena, shape.Vertices.data(), vertexSize);
+            mesh.IB = std::make_unique<IndexBuffer>(*m_Arena, shape.Indices.data(), (unsigned int)shape.Indices.size());
+            if (!mesh.VB->GetSize() || !mesh.IB->GetSize())
+                break;
+
+            mesh.VAO = std::make_unique<VertexArray>();
+            mesh.VAO->AddBuffer(*mesh.VB, layout);
+
+            glm::vec3 position(x(m_Random), y(m_Random), 0.0f);
+            mesh.Model = glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(size(m_Random)));
+            m_Meshes.push_back(std::move(mesh));
+        }
+	}
+
+	void TestBufferArena::FreeMeshes(unsigned int count)
+	{
+        // Al azar, para que los huecos queden repartidos por las pginas
+        for (unsigned int i = 0; i < count && !m_Meshes.empty(); i++)
+        {
+            unsigned int index = m_Random() % m_Meshes.size();
+            std::swap(m_Meshes[index], m_Meshes.back());
+            m_Meshes.pop_back();
+        }
+	}
+
+	void TestBufferArena::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestBufferArena::OnRender()
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+        Renderer::BeginScene(m_View, m_Proj);
+        for (const Mesh& mesh : m_Meshes)
+            m_Renderer.Submit(*mesh.VAO, *mesh.IB, *m_Shader, nullptr, mesh.Model);
+        m_Renderer.Flush();
+	}
+
+	void TestBufferArena::OnImGuiRender()
+	{
+        if (ImGui::Button("Add 100"))
+            AddMeshes(100);
+        ImGui::SameLine();
+        if (ImGui::Button("Free 100"))
+            FreeMeshes(100);
+        ImGui::SameLine();
+        if (ImGui::Button("Free half"))
+            FreeMeshes((unsigned int)m_Meshes.size() / 2);
+
+        BufferArena::Stats stats = m_Arena->GetStats();
+        ImGui::Text("Meshes: %zu (%u allocations)", m_Meshes.size(), stats.Allocations);
+        ImGui::Text("Pages: %u x %u KB", stats.Pages, m_Arena->GetPageSize() / 1024);
+        ImGui::Text("Used: %u KB of %u KB (%.1f%%)", stats.Used / 1024, stats.Capacity / 1024, stats.Occupancy() * 100.0f);
+        ImGui::Text("Rounding waste: %.1f%%", stats.InternalWaste() * 100.0f);
+        ImGui::Text("Largest free block: %u KB", stats.LargestFree / 1024);
+        ImGui::Text("Fragmentation: %.1f%%", stats.Fragmentation() * 100.0f);
+
+        const GLStateCache::Stats& cache = GLStateCache::GetFrameStats();
+        ImGui::Text("State cache: %u hits, %u misses", cache.Hits, cache.Misses);
+	}
+
+}
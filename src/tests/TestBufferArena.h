@@ -0,0 +1,61 @@
+#pragma once
+#include "BenchmarkTest.h"
+
+#include "Renderer.h"
+#include "BufferArena.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace test {
+
+	/// <summary>
+	/// Muchas mallas chicas, cada una con su VertexBuffer e IndexBuffer como vistas sobre un mismo BufferArena.
+	/// Se pueden agregar y liberar mallas al azar para ver cmo evolucionan la ocupacin y la fragmentacin.
+	/// </summary>
+	class TestBufferArena : public BenchmarkTest
+	{
+	public:
+		TestBufferArena();
+		~TestBufferArena();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		struct Mesh
+		{
+			std::unique_ptr<VertexBuffer> VB;
+			std::unique_ptr<IndexBuffer> IB;
+			std::unique_ptr<VertexArray> VAO;
+			glm::mat4 Model;
+		};
+
+		// Posicin y coordenada de textura de cada vrtice, como espera Basic.shader
+		struct ShapeData
+		{
+			std::vector<float> Vertices;
+			std::vector<unsigned int> Indices;
+		};
+
+		static const unsigned int PageSize = 1024 * 1024;
+		static const unsigned int MaxPages = 16;
+
+		void AddMeshes(unsigned int count);
+		void FreeMeshes(unsigned int count);
+
+		// Declarada antes que las mallas para destruirse despus de todas sus vistas
+		std::unique_ptr<BufferArena> m_Arena;
+		std::vector<Mesh> m_Meshes;
+		ShapeData m_Shapes[2];
+		std::mt19937 m_Random;
+
+		// Lo administra ShaderLibrary
+		Shader* m_Shader;
+		Renderer m_Renderer;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "TestBufferUpdate.h"
+
+#include "GLStateCache.h"
+#include "ShaderLibrary.h"
+#include "Profiler.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+
+	static const char* s_StrategyNames[] = { "SubData", "Orphan", "Map unsynchronized" };
+	static const int s_SweepSizes[] = { 1, 2, 4, 8, 16, 32, 64 };
+	static const int s_SweepSizeCount = sizeof(s_SweepSizes) / sizeof(s_SweepSizes[0]);
+
+	TestBufferUpdate::TestBufferUpdate() :
+        m_Region(0),
+        m_SizeMB(4),
+        m_Strategy((int)BufferUpdate::SubData)
+	{
+        m_Data.resize(MaxSizeMB * 1024 * 1024 / sizeof(Vertex));
+        glm::vec4 color(0.2f, 0.7f, 0.4f, 1.0f);
+        m_Data[0] = { glm::vec3(380.0f, 170.0f, 0.0f), color, glm::vec2(0.0f, 0.0f), 0.0f };
+        m_Data[1] = { glm::vec3(580.0f, 170.0f, 0.0f), color, glm::vec2(1.0f, 0.0f), 0.0f };
+        m_Data[2] = { glm::vec3(580.0f, 370.0f, 0.0f), color, glm::vec2(1.0f, 1.0f), 0.0f };
+        m_Data[3] = { glm::vec3(380.0f, 370.0f, 0.0f), color, glm::vec2(0.0f, 1.0f), 0.0f };
+
+        m_Buffer = std::make_unique<VertexBuffer>(0, BufferUsage::Stream);
+        SetRegionSize(m_SizeMB);
+
+        using Layout = VertexLayout<Vertex,
+            VERTEX_FIELD(Vertex, Position),
+            VERTEX_FIELD(Vertex, Color),
+            VERTEX_FIELD(Vertex, TexCoord),
+            VERTEX_FIELD(Vertex, TexIndex)>;
+        m_VAO = std::make_unique<VertexArray>();
+        m_VAO->AddBuffer(*m_Buffer, Layout::Elements, Layout::Stride);
+
+        unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
+        m_IndexBuffer = std::make_unique<IndexBuffer>(indices, 6);
+
+        unsigned int white = 0xffffffff;
+        m_WhiteTexture = std::make_unique<Texture>(1, 1, &white);
+
+        m_Shader = &ShaderLibrary::Get("res/shaders/Batch.shader");
+        int slot = 0;
+        m_Shader->Bind();
+        m_Shader->SetUniform1iv("u_Textures", 1, &slot);
+	}
+
+	TestBufferUpdate::~TestBufferUpdate()
+	{
+	}
+
+	void TestBufferUpdate::SetRegionSize(unsigned int sizeMB)
+	{
+        // Cada tramo tiene que empezar en un vrtice entero para poder dibujarlo con baseVertex
+        m_RegionSize = sizeMB * 1024 * 1024 / sizeof(Vertex) * sizeof(Vertex);
+        m_Buffer->Resize(m_RegionSize * RegionCount);
+        m_Region = 0;
+	}
+
+	void TestBufferUpdate::OnUpdate(float deltaTime)
+	{
+        if (!IsStepStart())
+            return;
+
+        int size = s_SweepSizes[GetSweepStep() / StrategyCount];
+        int strategy = GetSweepStep() % StrategyCount;
+        if (strategy == 0)
+            m_Sweep.push_back({ size, {} });
+        m_SizeMB = size;
+        m_Strategy = strategy;
+        SetRegionSize(size);
+	}
+
+	void TestBufferUpdate::OnRender()
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+        BufferUpdate update = (BufferUpdate)m_Strategy;
+        m_Buffer->SetUpdateStrategy(update);
+
+        // SubData y Orphan siempre escriben desde el principio; el mapeo sin sincronizar va rotando de tramo
+        unsigned int offset = update == BufferUpdate::MapUnsynchronized ? m_Region * m_RegionSize : 0;
+        m_Region = (m_Region + 1) % RegionCount;
+
+        double start = Profiler::Now();
+        m_Buffer->SetData(m_Data.data(), m_RegionSize, offset);
+        double elapsed = Profiler::Now() - start;
+        if (AddSample(elapsed))
+            m_Sweep.back().Time[m_Strategy] = GetStepResult();
+
+        Renderer::BeginScene(m_View, m_Proj);
+        m_VAO->Validate(*m_Shader);
+        m_Shader->Bind();
+        m_WhiteTexture->Bind(0);
+        m_VAO->Bind();
+        m_IndexBuffer->Bind();
+        GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, 6, m_IndexBuffer->GetType(), nullptr, offset / sizeof(Vertex)));
+	}
+
+	void TestBufferUpdate::OnImGuiRender()
+	{
+        if (GetSweepStep() >= 0)
+        {
+            ImGui::Text("Sweeping: %d MB, %s", m_SizeMB, s_StrategyNames[m_Strategy]);
+        }
+        else
+        {
+            if (ImGui::SliderInt("Size (MB)", &m_SizeMB, 1, MaxSizeMB))
+                SetRegionSize(m_SizeMB);
+            ImGui::Combo("Strategy", &m_Strategy, s_StrategyNames, StrategyCount);
+
+            if (ImGui::Button("Run sweep"))
+            {
+                m_Sweep.clear();
+                StartSweep(s_SweepSizeCount * StrategyCount);
+            }
+        }
+
+        ImGui::Text("SetData: %.1f us (%.2f GB/s)", GetAverage(), m_RegionSize / (GetAverage() * 1000.0));
+
+        if (!m_Sweep.empty() && ImGui::BeginTable("Sweep", StrategyCount + 1))
+        {
+            ImGui::TableSetupColumn("Size");
+            for (int i = 0; i < StrategyCount; i++)
+                ImGui::TableSetupColumn(s_StrategyNames[i]);
+            ImGui::TableHeadersRow();
+
+            for (const SweepResult& result : m_Sweep)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%d MB", result.SizeMB);
+                for (int i = 0; i < StrategyCount; i++)
+                {
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%.1f us", result.Time[i]);
+                }
+            }
+            ImGui::EndTable();
+        }
+	}
+
+}
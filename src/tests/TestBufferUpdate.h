@@ -0,0 +1,71 @@
+#pragma once
+#include "BenchmarkTest.h"
+
+#include "Renderer.h"
+#include "Texture.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	/// <summary>
+	/// Reescribe cada frame entre 1 y 64 MB de un VertexBuffer con cada BufferUpdate y mide cunto tarda SetData
+	/// en la CPU. Se dibuja un quad que sale del tramo recin escrito, as la GPU realmente usa el buffer y las
+	/// estrategias que se sincronizan con ella pagan lo que corresponde.
+	/// </summary>
+	class TestBufferUpdate : public BenchmarkTest
+	{
+	public:
+		TestBufferUpdate();
+		~TestBufferUpdate();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		struct Vertex
+		{
+			glm::vec3 Position;
+			glm::vec4 Color;
+			glm::vec2 TexCoord;
+			float TexIndex;
+		};
+
+		static const int MaxSizeMB = 64;
+		static const int StrategyCount = 3;
+		// Con MapUnsynchronized cada frame escribe en un tramo distinto, para no pisar lo que la GPU todava lee
+		static const unsigned int RegionCount = 3;
+
+		struct SweepResult
+		{
+			int SizeMB;
+			// Microsegundos promedio de SetData por estrategia
+			double Time[StrategyCount];
+		};
+
+		void SetRegionSize(unsigned int sizeMB);
+
+		std::unique_ptr<VertexBuffer> m_Buffer;
+		std::unique_ptr<VertexArray> m_VAO;
+		std::unique_ptr<IndexBuffer> m_IndexBuffer;
+		// Lo administra ShaderLibrary
+		Shader* m_Shader;
+		// El programa de Batch.shader se comparte con otros tests: el quad usa su propia textura blanca en el slot 0
+		std::unique_ptr<Texture> m_WhiteTexture;
+
+		// Lo que se sube cada frame: un quad al principio y relleno hasta MaxSizeMB
+		std::vector<Vertex> m_Data;
+		unsigned int m_RegionSize;
+		unsigned int m_Region;
+
+		int m_SizeMB;
+		int m_Strategy;
+
+		// Resultados del barrido: cada paso es un tamao con una estrategia
+		std::vector<SweepResult> m_Sweep;
+	};
+
+}
\ No newline at end of file
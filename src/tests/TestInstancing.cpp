@@ -0,0 +1,93 @@
+#include "TestInstancing.h"
+
+#include "GLStateCache.h"
+#include "ShaderLibrary.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+
+	TestInstancing::TestInstancing() :
+        m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 0.0f)),
+        m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+        m_Time(0.0f),
+        m_InstanceCount(5000),
+        m_UseCircles(true)
+	{
+        GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::SetBlend(true);
+
+        // Las mallas son de tamao 1 y la matriz de cada instancia las escala y ubica
+        m_Square = std::make_unique<Square>(1.0f);
+        m_Circle = std::make_unique<Circle>(0.5f);
+
+        m_Instances.resize(MaxInstances);
+        m_InstanceVB = std::make_unique<VertexBuffer>(MaxInstances * (unsigned int)sizeof(InstanceData));
+
+        VertexBufferLayout meshLayout;
+        meshLayout.Push<float>(2);
+
+        VertexBufferLayout instanceLayout;
+        for (int i = 0; i < 4; i++)
+            instanceLayout.Push<float>(4, 1);
+        instanceLayout.Push<float>(4, 1);
+
+        m_SquareVB = std::make_unique<VertexBuffer>(m_Square->GetPositions(), 2 * m_Square->GetVertices() * sizeof(float));
+        m_SquareIB = std::make_unique<IndexBuffer>(m_Square->GetIndexes(), 3 * m_Square->GetTriangles());
+
+        m_CircleVB = std::make_unique<VertexBuffer>(m_Circle->GetPositions(), 2 * m_Circle->GetVertices() * sizeof(float));
+        m_CircleIB = std::make_unique<IndexBuffer>(m_Circle->GetIndexes(), 3 * m_Circle->GetTriangles());
+
+        // Las dos mallas tienen el mismo layout, as que alcanza un VAO: al cambiar de figura solo se
+        // reemplaza el buffer del punto de enlace 0 con SetBuffer
+        m_VAO = std::make_unique<VertexArray>();
+        m_VAO->AddBuffer(*m_SquareVB, meshLayout);
+        m_VAO->AddBuffer(*m_InstanceVB, instanceLayout);
+
+        m_Shader = &ShaderLibrary::Get("res/shaders/Instanced.shader");
+	}
+
+	TestInstancing::~TestInstancing()
+	{
+	}
+
+	void TestInstancing::OnUpdate(float deltaTime)
+	{
+        m_Time += deltaTime;
+
+        // Cada instancia se ubica en una grilla y oscila un poco para que el buffer cambie en cada frame
+        int columns = (int)glm::ceil(glm::sqrt(m_InstanceCount * 960.0f / 540.0f));
+        float cell = 960.0f / columns;
+        for (int i = 0; i < m_InstanceCount; i++)
+        {
+            int x = i % columns;
+            int y = i / columns;
+            float offset = glm::sin(m_Time * 2.0f + i * 0.1f) * cell * 0.2f;
+
+            glm::vec3 position((x + 0.5f) * cell + offset, (y + 0.5f) * cell, 0.0f);
+            m_Instances[i].Model = glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(cell * 0.8f));
+            m_Instances[i].Color = glm::vec4((float)x / columns, 0.4f, (float)i / m_InstanceCount, 1.0f);
+        }
+	}
+
+	void TestInstancing::OnRender()
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+        m_InstanceVB->SetData(m_Instances.data(), m_InstanceCount * (unsigned int)sizeof(InstanceData));
+
+        Renderer::BeginScene(m_View, m_Proj);
+
+        m_VAO->SetBuffer(0, m_UseCircles ? *m_CircleVB : *m_SquareVB);
+        m_Renderer.DrawInstanced(*m_VAO, m_UseCircles ? *m_CircleIB : *m_SquareIB, *m_Shader, m_InstanceCount);
+	}
+
+	void TestInstancing::OnImGuiRender()
+	{
+        ImGui::SliderInt("Instances", &m_InstanceCount, 1, MaxInstances);
+        ImGui::Checkbox("Circles", &m_UseCircles);
+        ImGui::Text("1 draw call, %d instances", m_InstanceCount);
+	}
+
+}
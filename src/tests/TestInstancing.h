@@ -0,0 +1,59 @@
+#pragma once
+#include "Test.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "shapes/Square.h"
+#include "shapes/Circle.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	class TestInstancing : public Test
+	{
+	public:
+		TestInstancing();
+		~TestInstancing();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		struct InstanceData
+		{
+			glm::mat4 Model;
+			glm::vec4 Color;
+		};
+
+		static const int MaxInstances = 20000;
+
+		// Una malla por figura; las dos comparten el mismo buffer de instancias
+		std::unique_ptr<Square> m_Square;
+		std::unique_ptr<Circle> m_Circle;
+		std::unique_ptr<VertexBuffer> m_SquareVB, m_CircleVB;
+		std::unique_ptr<IndexBuffer> m_SquareIB, m_CircleIB;
+		// Lee la malla de la figura elegida (punto de enlace 0) y las instancias (punto de enlace 1)
+		std::unique_ptr<VertexArray> m_VAO;
+
+		std::unique_ptr<VertexBuffer> m_InstanceVB;
+		std::vector<InstanceData> m_Instances;
+
+		// Lo administra ShaderLibrary
+		Shader* m_Shader;
+		Renderer m_Renderer;
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		float m_Time;
+		int m_InstanceCount;
+		bool m_UseCircles;
+	};
+
+}
\ No newline at end of file
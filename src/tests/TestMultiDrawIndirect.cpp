@@ -0,0 +1,88 @@
+#include "TestMultiDrawIndirect.h"
+
+#include "GLStateCache.h"
+#include "ShaderLibrary.h"
+
+#include "imgui/imgui.h"
+
+namespace test {
+
+	TestMultiDrawIndirect::TestMultiDrawIndirect() :
+        m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 0.0f)),
+        m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
+        m_Time(0.0f),
+        m_InstanceCount(5000)
+	{
+        GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::SetBlend(true);
+
+        VertexBufferLayout meshLayout;
+        meshLayout.Push<float>(2);
+
+        // Las figuras se copian al pool y despus ya no hacen falta
+        m_Pool = std::make_unique<MeshPool>(meshLayout, 1024, 4096);
+        m_SquareMesh = m_Pool->Add(Square(1.0f));
+        m_CircleMesh = m_Pool->Add(Circle(0.5f));
+
+        m_Instances.resize(MaxInstances);
+        m_InstanceVB = std::make_unique<VertexBuffer>(MaxInstances * (unsigned int)sizeof(InstanceData));
+
+        VertexBufferLayout instanceLayout;
+        for (int i = 0; i < 4; i++)
+            instanceLayout.Push<float>(4, 1);
+        instanceLayout.Push<float>(4, 1);
+        m_Pool->SetInstanceBuffer(*m_InstanceVB, instanceLayout);
+
+        m_Shader = &ShaderLibrary::Get("res/shaders/Instanced.shader");
+	}
+
+	TestMultiDrawIndirect::~TestMultiDrawIndirect()
+	{
+	}
+
+	void TestMultiDrawIndirect::OnUpdate(float deltaTime)
+	{
+        m_Time += deltaTime;
+
+        // Cuadrados y crculos se alternan en la grilla, pero en el buffer quedan en dos tramos contiguos
+        int squares = (m_InstanceCount + 1) / 2;
+        int columns = (int)glm::ceil(glm::sqrt(m_InstanceCount * 960.0f / 540.0f));
+        float cell = 960.0f / columns;
+        for (int i = 0; i < m_InstanceCount; i++)
+        {
+            int cellIndex = i < squares ? i * 2 : (i - squares) * 2 + 1;
+            int x = cellIndex % columns;
+            int y = cellIndex / columns;
+            float offset = glm::sin(m_Time * 2.0f + cellIndex * 0.1f) * cell * 0.2f;
+
+            glm::vec3 position((x + 0.5f) * cell + offset, (y + 0.5f) * cell, 0.0f);
+            m_Instances[i].Model = glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(cell * 0.8f));
+            m_Instances[i].Color = i < squares ? glm::vec4(0.9f, 0.5f, 0.2f, 1.0f) : glm::vec4(0.2f, 0.6f, 0.9f, 1.0f);
+        }
+	}
+
+	void TestMultiDrawIndirect::OnRender()
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+        m_InstanceVB->SetData(m_Instances.data(), m_InstanceCount * (unsigned int)sizeof(InstanceData));
+
+        Renderer::BeginScene(m_View, m_Proj);
+
+        unsigned int squares = (m_InstanceCount + 1) / 2;
+        Renderer::IndirectDraw draws[] = {
+            { &m_SquareMesh, squares, 0 },
+            { &m_CircleMesh, m_InstanceCount - squares, squares }
+        };
+        m_Renderer.DrawIndirect(*m_Pool, *m_Shader, draws, 2);
+	}
+
+	void TestMultiDrawIndirect::OnImGuiRender()
+	{
+        ImGui::SliderInt("Instances", &m_InstanceCount, 1, MaxInstances);
+        ImGui::Text("1 draw call, 2 meshes, %d instances", m_InstanceCount);
+        ImGui::Text("Pool: %u vertices, %u indices", m_Pool->GetVertexCount(), m_Pool->GetIndexCount());
+	}
+
+}
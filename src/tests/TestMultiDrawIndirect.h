@@ -0,0 +1,57 @@
+#pragma once
+#include "Test.h"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include "Renderer.h"
+#include "MeshPool.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "shapes/Square.h"
+#include "shapes/Circle.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	class TestMultiDrawIndirect : public Test
+	{
+	public:
+		TestMultiDrawIndirect();
+		~TestMultiDrawIndirect();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		struct InstanceData
+		{
+			glm::mat4 Model;
+			glm::vec4 Color;
+		};
+
+		static const int MaxInstances = 20000;
+
+		// Cuadrados y crculos viven en el mismo pool, as que comparten VAO y se dibujan con una sola llamada
+		std::unique_ptr<MeshPool> m_Pool;
+		MeshHandle m_SquareMesh;
+		MeshHandle m_CircleMesh;
+
+		// Primero van las instancias de los cuadrados y despus las de los crculos
+		std::unique_ptr<VertexBuffer> m_InstanceVB;
+		std::vector<InstanceData> m_Instances;
+
+		// Lo administra ShaderLibrary
+		Shader* m_Shader;
+		Renderer m_Renderer;
+
+		glm::mat4 m_Proj;
+		glm::mat4 m_View;
+
+		float m_Time;
+		int m_InstanceCount;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "TestShapeFormats.h"
+
+#include <cstring>
+
+#include "GLStateCache.h"
+#include "Profiler.h"
+#include "ShaderLibrary.h"
+
+#include "imgui/imgui.h"
+
+#include "shapes/Circle.h"
+
+namespace test {
+
+	static const char* s_FormatNames[] = { "Float", "Quantized" };
+
+	TestShapeFormats::TestShapeFormats() :
+        BenchmarkTest(SweepFrames, WarmupFrames),
+        m_LastFrame(~0ull),
+        m_Format((int)ShapeVertexFormat::Quantized),
+        m_InstanceCount(2000),
+        m_SweepResults()
+	{
+        m_InstanceVB = std::make_unique<VertexBuffer>(MaxInstances * (unsigned int)sizeof(glm::mat4));
+        PlaceInstances();
+
+        VertexBufferLayout instanceLayout;
+        for (int i = 0; i < 4; i++)
+            instanceLayout.Push<float>(4, 1);
+
+        Circle circle(0.5f);
+        for (int format = 0; format < FormatCount; format++)
+        {
+            Mesh& mesh = m_Meshes[format];
+            mesh.Packed = ShapePacker::Pack(circle, (ShapeVertexFormat)format, glm::vec4(0.3f, 0.8f, 0.5f, 1.0f));
+            mesh.VB = std::make_unique<VertexBuffer>(mesh.Packed.Vertices.data(), (unsigned int)mesh.Packed.Vertices.size());
+            mesh.IB = std::make_unique<IndexBuffer>(mesh.Packed.Indices.data(), (unsigned int)mesh.Packed.Indices.size());
+            mesh.VAO = std::make_unique<VertexArray>();
+            ShapePacker::AddBuffer(*mesh.VAO, *mesh.VB, (ShapeVertexFormat)format);
+            mesh.VAO->AddBuffer(*m_InstanceVB, instanceLayout);
+        }
+
+        m_Shader = ShapePacker::ResolveShader(ShaderLibrary::Get("res/shaders/Shape.shader"));
+	}
+
+	TestShapeFormats::~TestShapeFormats()
+	{
+	}
+
+	void TestShapeFormats::PlaceInstances()
+	{
+        // Una grilla fija: la escena es esttica y lo nico que cambia entre formatos son los vrtices
+        std::vector<glm::mat4> instances(m_InstanceCount);
+        int columns = (int)glm::ceil(glm::sqrt(m_InstanceCount * 960.0f / 540.0f));
+        float cell = 960.0f / columns;
+        for (int i = 0; i < m_InstanceCount; i++)
+        {
+            glm::vec3 position((i % columns + 0.5f) * cell, (i / columns + 0.5f) * cell, 0.0f);
+            instances[i] = glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(cell * 0.9f));
+        }
+        m_InstanceVB->SetData(instances.data(), m_InstanceCount * (unsigned int)sizeof(glm::mat4));
+	}
+
+	double TestShapeFormats::ReadDrawTime()
+	{
+        const ProfileFrame* frame = Profiler::GetLastGpuFrame();
+        if (!frame || frame->Index == m_LastFrame)
+            return -1.0;
+
+        m_LastFrame = frame->Index;
+        for (const ProfileZone& zone : frame->Zones)
+        {
+            if (zone.Gpu && std::strcmp(zone.Name, "Shape draw") == 0)
+                return zone.End - zone.Start;
+        }
+        return -1.0;
+	}
+
+	void TestShapeFormats::OnUpdate(float deltaTime)
+	{
+	}
+
+	void TestShapeFormats::OnRender()
+	{
+		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		GLCall(glClear(GL_COLOR_BUFFER_BIT));
+
+        // El resultado es de hasta Profiler::QueryRingSize frames atrs; el barrido descarta los primeros frames de cada formato
+        double elapsed = ReadDrawTime();
+        int step = GetSweepStep();
+        if (AddSample(elapsed))
+            m_SweepResults[step] = GetStepResult();
+        if (GetSweepStep() >= 0)
+            m_Format = GetSweepStep();
+
+        const Mesh& mesh = m_Meshes[m_Format];
+        Shader& shader = ShapePacker::PrepareShader(m_Shader, mesh.Packed);
+
+        Renderer::BeginScene(m_View, m_Proj);
+
+        {
+            PROFILE_GPU_SCOPE("Shape draw");
+            m_Renderer.DrawInstanced(*mesh.VAO, *mesh.IB, shader, m_InstanceCount);
+        }
+	}
+
+	void TestShapeFormats::OnImGuiRender()
+	{
+        if (GetSweepStep() >= 0)
+        {
+            ImGui::Text("Comparing: %s", s_FormatNames[m_Format]);
+        }
+        else
+        {
+            if (ImGui::SliderInt("Circles", &m_InstanceCount, 1, MaxInstances))
+                PlaceInstances();
+            ImGui::Combo("Format", &m_Format, s_FormatNames, FormatCount);
+
+            if (ImGui::Button("Compare formats"))
+            {
+                StartSweep(FormatCount);
+                m_Format = 0;
+            }
+        }
+
+        const Mesh& mesh = m_Meshes[m_Format];
+        ImGui::Text("%u vertices x %u bytes = %u bytes", mesh.Packed.VertexCount, mesh.Packed.Stride, (unsigned int)mesh.Packed.Vertices.size());
+        ImGui::Text("Vertex data read per frame: %.1f MB", (double)mesh.Packed.Vertices.size() * m_InstanceCount / (1024.0 * 1024.0));
+        if (g_GLCaps.TimerQuery)
+            ImGui::Text("GPU: %.1f us", GetAverage());
+        else
+            ImGui::Text("GPU: timer queries not available");
+
+        for (int i = 0; i < FormatCount; i++)
+        {
+            if (m_SweepResults[i] > 0.0)
+                ImGui::Text("%s: %.1f us GPU, %u bytes/vertex", s_FormatNames[i], m_SweepResults[i], m_Meshes[i].Packed.Stride);
+        }
+	}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "BenchmarkTest.h"
+
+#include "Renderer.h"
+#include "VertexBuffer.h"
+#include "VertexBufferLayout.h"
+#include "shapes/ShapePacker.h"
+
+#include <memory>
+#include <vector>
+
+namespace test {
+
+	/// <summary>
+	/// Dibuja una escena esttica de muchos crculos instanciados con cada ShapeVertexFormat y compara la memoria
+	/// de vrtices y el tiempo de GPU del draw (una zona de GPU del Profiler, leda sin esperar a la GPU).
+	/// </summary>
+	class TestShapeFormats : public BenchmarkTest
+	{
+	public:
+		TestShapeFormats();
+		~TestShapeFormats();
+
+		void OnUpdate(float deltaTime) override;
+		void OnRender() override;
+		void OnImGuiRender() override;
+	private:
+		static const int FormatCount = 2;
+		static const int MaxInstances = 20000;
+		static const unsigned int SweepFrames = 60;
+		static const unsigned int WarmupFrames = 10;
+
+		struct Mesh
+		{
+			PackedShape Packed;
+			std::unique_ptr<VertexBuffer> VB;
+			std::unique_ptr<IndexBuffer> IB;
+			std::unique_ptr<VertexArray> VAO;
+		};
+
+		void PlaceInstances();
+		// Microsegundos de GPU del draw en el ltimo frame que ley el Profiler; si no hay uno nuevo, un valor negativo
+		double ReadDrawTime();
+
+		Mesh m_Meshes[FormatCount];
+		std::unique_ptr<VertexBuffer> m_InstanceVB;
+		// Las variantes las administra ShaderLibrary
+		ShapeShader m_Shader;
+		Renderer m_Renderer;
+
+		// ndice del ltimo frame del Profiler que se ley, para no contar dos veces el mismo
+		unsigned long long m_LastFrame;
+
+		int m_Format;
+		int m_InstanceCount;
+
+		// Microsegundos de GPU promedio por formato; cada paso del barrido es un formato
+		double m_SweepResults[FormatCount];
+	};
+
+}
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include "TestTexture2D.h"
 
 #include "Renderer.h"
+#include "GLStateCache.h"
+#include "ShaderLibrary.h"
+#include "VertexArrayCache.h"
 
 #include "imgui/imgui.h"
 
@@ -9,32 +12,34 @@
 namespace test {
 
 	TestTexture2D::TestTexture2D() :
+        m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 0.0f)),
+        m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0))),
         m_TranslationA(200, 200, 0),
         m_TranslationB(400, 400, 0),
-        m_Proj(glm::ortho(0.0f, 960.0f, 0.0f, 540.0f, -1.0f, 0.0f)),
-        m_View(glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, 0)))
+        m_ColorB(0.8f, 0.3f, 0.8f, 1.0f)
 	{
         m_Shape = std::make_unique<Square>(100.0f, true, true);
         unsigned int triangles_qnty = m_Shape->GetTriangles();
         unsigned int vertices_qnty = m_Shape->GetVertices();
 
-        GLCall(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-        GLCall(glEnable(GL_BLEND));
-
-        m_VAO = std::make_unique<VertexArray>();
+        GLStateCache::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::SetBlend(true);
 
         m_VertexBuffer = std::make_unique<VertexBuffer>(m_Shape->GetPositions(), 2 * vertices_qnty * 2 * sizeof(float));
 
         VertexBufferLayout layout;
         layout.Push<float>(2);
         layout.Push<float>(2);
-        m_VAO->AddBuffer(*m_VertexBuffer, layout);
+        // Cualquier otro que dibuje este buffer con el mismo layout recibe el mismo VAO
+        m_VAO = &VertexArrayCache::Get(*m_VertexBuffer, layout);
 
         m_IndexBuffer = std::make_unique<IndexBuffer>(m_Shape->GetIndexes(), 3 * triangles_qnty);
 
-        m_Shader = std::make_unique<Shader>("res/shaders/Basic.shader");
+        m_FlatShader = &ShaderLibrary::Get("res/shaders/Basic.shader");
+        m_FlatColor = m_FlatShader->GetUniform("u_Color");
+        m_Shader = &m_FlatShader->GetVariant({ "USE_TEXTURE" });
         m_Shader->Bind();
-        m_Shader->SetUniform4f("u_Color", 0.8f, 0.3f, 0.8f, 1.0f);
+        m_Shader->SetUniform4f("u_Color", 1.0f, 1.0f, 1.0f, 1.0f);
 
         m_Texture = std::make_unique<Texture>("res/textures/TheCherno.png");
         m_Shader->SetUniform1i("u_Texture", 0);
@@ -53,25 +58,15 @@ namespace test {
 		GLCall(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
 		GLCall(glClear(GL_COLOR_BUFFER_BIT));
 
-        Renderer renderer;
-
-        m_Texture->Bind();
-
-        {
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), m_TranslationA);
-            glm::mat4 mvp = m_Proj * m_View * model;
-            m_Shader->Bind();
-            m_Shader->SetUniformMat4f("u_MVP", mvp);
-            renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
-        }
-
-        {
-            glm::mat4 model = glm::translate(glm::mat4(1.0f), m_TranslationB);
-            glm::mat4 mvp = m_Proj * m_View * model;
-            m_Shader->Bind();
-            m_Shader->SetUniformMat4f("u_MVP", mvp);
-            renderer.Draw(*m_VAO, *m_IndexBuffer, *m_Shader);
-        }
+        Renderer::BeginScene(m_View, m_Proj);
+
+        m_FlatShader->Bind();
+        m_FlatShader->SetUniform4f(m_FlatColor, m_ColorB.r, m_ColorB.g, m_ColorB.b, m_ColorB.a);
+
+        m_Renderer.Submit(*m_VAO, *m_IndexBuffer, *m_Shader, m_Texture.get(), glm::translate(glm::mat4(1.0f), m_TranslationA));
+        m_Renderer.Submit(*m_VAO, *m_IndexBuffer, *m_FlatShader, nullptr, glm::translate(glm::mat4(1.0f), m_TranslationB));
+
+        m_Renderer.Flush();
 	}
 
 	void TestTexture2D::OnImGuiRender()
@@ -81,6 +76,12 @@ namespace test {
 
         ImGui::SliderFloat("TranslationB X", &m_TranslationB.x, 0.0f, 960.0f);
         ImGui::SliderFloat("TranslationB Y", &m_TranslationB.y, 0.0f, 540.0f);
+        ImGui::ColorEdit4("Color B", &m_ColorB.r);
+
+        const Renderer::Stats& stats = m_Renderer.GetStats();
+        ImGui::Text("Draw commands: %u", stats.Commands);
+        ImGui::Text("State changes: %u (saved by sorting: %u)", stats.StateChanges, stats.StateChangesSaved);
+        ImGui::Text("Uniform buffer uploads: %u", stats.UniformUploads);
 	}
 
 }
@@ -24,17 +24,24 @@ namespace test {
 		void OnRender() override;
 		void OnImGuiRender() override;
 	private:
-		std::unique_ptr<VertexArray> m_VAO;
+		// Lo administra VertexArrayCache y vive mientras viva m_VertexBuffer
+		VertexArray* m_VAO;
 		std::unique_ptr<VertexBuffer> m_VertexBuffer;
 		std::unique_ptr<IndexBuffer> m_IndexBuffer;
-		std::unique_ptr<Shader> m_Shader;
+		// Variantes de Basic.shader, las administra ShaderLibrary: A se dibuja con la textura y B con un color plano
+		Shader* m_Shader;
+		Shader* m_FlatShader;
+		UniformHandle m_FlatColor;
 		std::unique_ptr<Texture> m_Texture;
 		std::unique_ptr<Square> m_Shape;
 
+		Renderer m_Renderer;
+
 		glm::mat4 m_Proj;
 		glm::mat4 m_View;
 
 		glm::vec3 m_TranslationA, m_TranslationB;
+		glm::vec4 m_ColorB;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,190 @@
+/*
+	shader_cook: preprocesa todos los .shader de un directorio (con todas las combinaciones de sus #feature),
+	los valida con glslangValidator si est instalado y escribe un ShaderBundle con el cdigo ya separado
+	por etapa y sin comentarios.
+
+	Uso: shader_cook [directorio de shaders] [paquete de salida]
+	Por defecto lee res/shaders y escribe res/shaders.bundle, as que se corre desde la carpeta del proyecto.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ShaderPreprocessor.h"
+#include "ShaderBundle.h"
+
+// Ms claves que esto generara demasiadas variantes; las combinaciones que falten se compilan desde el cdigo
+static const unsigned int s_MaxCookedFeatures = 6;
+
+#ifdef _WIN32
+static const char* s_NullDevice = "nul";
+#else
+static const char* s_NullDevice = "/dev/null";
+#endif
+
+/// <summary>
+/// Saca comentarios, espacios al principio y al final de cada lnea y lneas vacas. Los saltos de lnea
+/// se conservan porque las directivas del preprocesador de GLSL terminan ah.
+/// </summary>
+static std::string Minify(const std::string& source)
+{
+	std::string result;
+	std::string line;
+	bool blockComment = false;
+
+	for (size_t i = 0; i <= source.size(); i++)
+	{
+		char c = i < source.size() ? source[i] : '\n';
+		char next = i + 1 < source.size() ? source[i + 1] : '\0';
+
+		if (blockComment)
+		{
+			if (c == '*' && next == '/')
+			{
+				blockComment = false;
+				i++;
+			}
+			continue;
+		}
+
+		if (c == '/' && next == '*')
+		{
+			blockComment = true;
+			i++;
+			line += ' ';
+			continue;
+		}
+
+		if (c == '/' && next == '/')
+		{
+			while (i + 1 < source.size() && source[i + 1] != '\n')
+				i++;
+			continue;
+		}
+
+		if (c != '\n')
+		{
+			// Las tiras de espacios se reducen a uno solo
+			bool space = c == ' ' || c == '\t' || c == '\r';
+			if (!space)
+				line += c;
+			else if (!line.empty() && line.back() != ' ')
+				line += ' ';
+			continue;
+		}
+
+		while (!line.empty() && line.back() == ' ')
+			line.pop_back();
+		if (!line.empty())
+			result += line + '\n';
+		line.clear();
+	}
+
+	return result;
+}
+
+static bool HasValidator()
+{
+	std::string command = std::string("glslangValidator --version > ") + s_NullDevice + " 2>&1";
+	return std::system(command.c_str()) == 0;
+}
+
+// Compila una etapa con glslangValidator. El cdigo se escribe a un archivo temporal con la extensin de la etapa
+static bool Validate(const std::string& source, const char* stage, const std::string& name)
+{
+	std::filesystem::path path = std::filesystem::temp_directory_path() / (std::string("shader_cook.") + stage);
+	{
+		std::ofstream stream(path);
+		stream << source;
+	}
+
+	std::string command = "glslangValidator \"" + path.string() + "\"";
+	bool valid = std::system(command.c_str()) == 0;
+	if (!valid)
+		std::cout << "shader_cook: " << name << " (" << stage << ") failed validation" << std::endl;
+
+	std::filesystem::remove(path);
+	return valid;
+}
+
+int main(int argc, char** argv)
+{
+	std::string directory = argc > 1 ? argv[1] : "res/shaders";
+	std::string output = argc > 2 ? argv[2] : "res/shaders.bundle";
+
+	std::vector<std::string> files;
+	std::error_code error;
+	for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+	{
+		if (entry.path().extension() == ".shader")
+			files.push_back((std::filesystem::path(directory) / entry.path().filename()).generic_string());
+	}
+	if (error)
+	{
+		std::cout << "shader_cook: can't read '" << directory << "'" << std::endl;
+		return 1;
+	}
+	std::sort(files.begin(), files.end());
+
+	bool validate = HasValidator();
+	if (!validate)
+		std::cout << "shader_cook: glslangValidator not found, skipping validation" << std::endl;
+
+	std::vector<PreprocessedShader> shaders;
+	bool valid = true;
+	for (const std::string& file : files)
+	{
+		std::vector<std::string> features = ShaderPreprocessor::Process(file, {}).Features;
+		if (features.size() > s_MaxCookedFeatures)
+		{
+			std::cout << "shader_cook: " << file << " declares " << features.size() << " features, only the first "
+				<< s_MaxCookedFeatures << " are cooked" << std::endl;
+			features.resize(s_MaxCookedFeatures);
+		}
+
+		// Una variante por combinacin, con las claves en el orden en que las arma Shader::GetVariant
+		for (uint32_t mask = 0; mask < (1u << features.size()); mask++)
+		{
+			std::vector<std::string> defines;
+			for (unsigned int i = 0; i < features.size(); i++)
+			{
+				if (mask & (1u << i))
+					defines.push_back(features[i]);
+			}
+
+			PreprocessedShader shader = ShaderPreprocessor::Process(file, defines);
+			shader.Source.VertexSource = Minify(shader.Source.VertexSource);
+			shader.Source.FragmentSource = Minify(shader.Source.FragmentSource);
+
+			std::string name = file;
+			for (const std::string& define : defines)
+				name += " +" + define;
+
+			if (validate)
+			{
+				valid &= Validate(shader.Source.VertexSource, "vert", name);
+				valid &= Validate(shader.Source.FragmentSource, "frag", name);
+			}
+
+			std::cout << name << std::endl;
+			shaders.push_back(std::move(shader));
+		}
+	}
+
+	if (!valid)
+		return 1;
+
+	if (!ShaderBundle::Write(output, shaders))
+	{
+		std::cout << "shader_cook: can't write '" << output << "'" << std::endl;
+		return 1;
+	}
+
+	std::cout << "shader_cook: " << shaders.size() << " programs written to " << output << std::endl;
+	return 0;
+}